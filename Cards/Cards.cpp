@@ -5,22 +5,61 @@
 #include<iostream>
 #include <sstream>
 #include "../Cards/Cards.h"
-#include <ctime>
+#include <cstdlib>
 #include <vector>
 
 using namespace std;
 
-Card::Card(){
+namespace {
+    const string CARD_TYPE_NAMES[NUM_CARD_TYPES] = {"bomb", "reinforcement", "blockade", "airlift", "diplomacy"};
+
+    // lists the cards of a card-count array, grouped by type, 3 per line
+    string printCardCounts(const int *cardCounts) {
+        std::ostringstream buffer;
+        bool newLine = false;
+        int position = 0;
+        for (int type = 0; type < NUM_CARD_TYPES; type++) {
+            for (int i = 0; i < cardCounts[type]; i++) {
+                newLine = false;
+                position++;
+                buffer << "[Card " << position << ": " << CARD_TYPE_NAMES[type] << "]\t\t";
+                if (position % 3 == 0) {
+                    buffer << "\n";
+                    newLine = true;
+                }
+            }
+        }
+        if (!newLine) { buffer << "\n"; }
+        return buffer.str();
+    }
+}
+
+string cardTypeToString(CardType type) {
+    return CARD_TYPE_NAMES[static_cast<int>(type)];
+}
+
+bool stringToCardType(const string &name, CardType &type) {
+    for (int i = 0; i < NUM_CARD_TYPES; i++) {
+        if (name == CARD_TYPE_NAMES[i]) {
+            type = static_cast<CardType>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+Card::Card() : type(CardType::Bomb){
 }
 
 Card::Card(string type) {
-    this->type = type;
-    testType();
+    setType(type);
+}
+
+Card::Card(CardType type) : type(type){
 }
 
 Card::Card(const Card& c){
     type = c.type;
-    testType();
 }
 
 Card::~Card() {
@@ -29,7 +68,6 @@ Card::~Card() {
 
 Card& Card::operator=(const Card& c){
     type = c.type;
-    testType();
     return *this;
 }
 
@@ -38,53 +76,49 @@ std::ostream& operator<<(std::ostream& stream, const Card& c){
 }
 
 string Card::getType() const {
+    return cardTypeToString(type);
+}
+
+CardType Card::getCardType() const {
     return type;
 }
 
+// guards against invalid card types, as the constructor taking a string used to
 void Card::setType(string typer) {
-    type = typer;
+    if (!stringToCardType(typer, type)) {
+        cout << "Invalid card type\n";
+        exit(1);
+    }
 }
 
 string Card::printCard() const{
     std::ostringstream buffer;
-    buffer << type << " type card";
+    buffer << getType() << " type card";
     return buffer.str();
 }
 
-Card* Card::play(Player *&player) {
-    cout << "Played a card of type " << type << endl;
+void Card::play(Player *&player) {
+    cout << "Played a card of type " << getType() << endl;
     OrdersList* lister = player->getPlayerOrdersList();
-    if (type.compare("bomb") == 0) {
-        lister->add(new BombOrder());
-    } else if (type.compare("reinforcement") == 0) {
-        lister->add(new AdvanceOrder());
-    } else if (type.compare("blockade") == 0) {
-        lister->add(new BlockadeOrder());
-    } else if (type.compare("airlift") == 0) {
-        lister->add(new AirliftOrder());
-    } else if (type.compare("diplomacy") == 0) {
-        lister->add(new NegotiateOrder());
-    }
-    return this;
-}
-
-
-
-void Card::testType() {
-    string validTypes[] = {"bomb", "reinforcement", "blockade", "airlift", "diplomacy"};
-    bool correct = false;
-    for (int i = 0; i < validTypes->size()+1; i++) {
-        if (type.compare(validTypes[i]) == 0) {
-            correct = true;
+    switch (type) {
+        case CardType::Bomb:
+            lister->add(new BombOrder());
+            break;
+        case CardType::Reinforcement:
+            lister->add(new AdvanceOrder());
+            break;
+        case CardType::Blockade:
+            lister->add(new BlockadeOrder());
+            break;
+        case CardType::Airlift:
+            lister->add(new AirliftOrder());
+            break;
+        case CardType::Diplomacy:
+            lister->add(new NegotiateOrder());
             break;
-        }
-    }
-    if (correct == false) {
-        cout << "Invalid card type\n";
-        exit(1);
     }
-
 }
+
 /**
  *
  * @param player the player using his card to issue order
@@ -93,53 +127,61 @@ void Card::testType() {
  * @param target the target territory
  */
 void Card::useCardtoCreateOrder(Player *player, int numArmies, Territory *source, Territory *target) {
-    if (type.compare("bomb") == 0) {
-        BombOrder *bombOrder = new BombOrder(player,target);
-        player->getPlayerOrdersList()->add(bombOrder);
-        cout<<player->getName() << " used " << *this << " to issue "<<* bombOrder <<endl;
-    } else if (type.compare("blockade") == 0) {
-        BlockadeOrder *blockadeOrder = new BlockadeOrder(player, source);
-        player->getPlayerOrdersList()->add(blockadeOrder);
-        cout<<player->getName() << " used " << *this << " to issue "<< *blockadeOrder <<endl;
-    } else if (type.compare("airlift") == 0) {
-        AirliftOrder *airliftOrder = new AirliftOrder(player, numArmies, source, target);
-        player->getPlayerOrdersList()->add(airliftOrder);
-        cout<<player->getName() << " used " << *this << " to issue "<< *airliftOrder <<endl;
-    } else if (type.compare("negotiate") == 0) {
-        NegotiateOrder *negotiateOrder = new NegotiateOrder(player, target->getOwner());
-        player->getPlayerOrdersList()->add(negotiateOrder);
-        cout<<player->getName() << " used " << *this << " to issue "<< *negotiateOrder <<endl;
+    switch (type) {
+        case CardType::Bomb: {
+            BombOrder *bombOrder = new BombOrder(player,target);
+            player->getPlayerOrdersList()->add(bombOrder);
+            cout<<player->getName() << " used " << *this << " to issue "<<* bombOrder <<endl;
+            break;
+        }
+        case CardType::Blockade: {
+            BlockadeOrder *blockadeOrder = new BlockadeOrder(player, source);
+            player->getPlayerOrdersList()->add(blockadeOrder);
+            cout<<player->getName() << " used " << *this << " to issue "<< *blockadeOrder <<endl;
+            break;
+        }
+        case CardType::Airlift: {
+            AirliftOrder *airliftOrder = new AirliftOrder(player, numArmies, source, target);
+            player->getPlayerOrdersList()->add(airliftOrder);
+            cout<<player->getName() << " used " << *this << " to issue "<< *airliftOrder <<endl;
+            break;
+        }
+        case CardType::Diplomacy: {
+            // the negotiation is with the owner of the target, a player never negotiates with itself
+            if (target == nullptr || target->getOwner() == nullptr || target->getOwner() == player) {
+                break;
+            }
+            NegotiateOrder *negotiateOrder = new NegotiateOrder(player, target->getOwner());
+            player->getPlayerOrdersList()->add(negotiateOrder);
+            cout<<player->getName() << " used " << *this << " to issue "<< *negotiateOrder <<endl;
+            break;
+        }
+        case CardType::Reinforcement:
+            break;
     }
 }
 
-Deck::Deck(){
-}
-
-Deck::Deck(vector<Card*> &cards) : cards(cards){
+Deck::Deck() : size(0){
+    for (int &count : cardCounts) {
+        count = 0;
+    }
 }
 
-Deck::Deck(const Deck& d){
-    for (Card* card : d.cards) {
-        this->cards.push_back(new Card(*card));
+Deck::Deck(const Deck& d) : size(d.size){
+    for (int i = 0; i < NUM_CARD_TYPES; i++) {
+        cardCounts[i] = d.cardCounts[i];
     }
 }
 
 Deck::~Deck() {
-    for (Card* card : cards) {
-        if(card != nullptr) {
-            delete card;
-            card = nullptr;
-        }
-    }
-    cards.erase(cards.begin(), cards.end());
+    // nothing, the deck does not own any card object
 }
 
 Deck& Deck::operator=(const Deck& d){
-    vector<Card*> copyOfDeck;
-    for (int i = 0; i < d.cards.size(); i++) {
-        copyOfDeck.push_back(new Card(*d.cards[i]));
+    for (int i = 0; i < NUM_CARD_TYPES; i++) {
+        cardCounts[i] = d.cardCounts[i];
     }
-    cards = copyOfDeck;
+    size = d.size;
     return *this;
 }
 
@@ -147,75 +189,90 @@ std::ostream& operator<<(std::ostream& stream, const Deck& d){
     return stream << "Deck details, size: " << d.getSize() << endl << "Cards in deck: \n" << d.printDeck();
 }
 
-int Deck::getSize() const { return cards.size(); }
+int Deck::getSize() const { return size; }
+
+int Deck::getCount(CardType type) const {
+    return cardCounts[static_cast<int>(type)];
+}
 
 string Deck::printDeck() const{
-    std::ostringstream buffer;
-    bool newLine = false;
-    if (cards.size() <= 0) {
+    if (size <= 0) {
         return "Deck is empty!";
     }
-    for (int i = 0; i < cards.size(); i++) {
-        newLine = false;
-        buffer << "[Card " << (i + 1) << ": " << cards[i]->getType() << "]\t\t";
-        if ((i+1) % 3 == 0) {
-            buffer << "\n";
-            newLine = true;
-        }
-    }
-    if (!newLine) { buffer << "\n"; }
-    return buffer.str();
+    return printCardCounts(cardCounts);
 }
 
-void Deck::addCard(Card* card) {
-    cards.push_back(card);
+void Deck::addCard(CardType type) {
+    addCards(type, 1);
 }
 
 void Deck::addCard(string type) {
-    Card toAdd(type);
-    Card* addPointer = &toAdd;
-    cards.push_back(addPointer);
+    addCard(Card(type).getCardType());
 }
 
-Card* Deck::draw() {
-    if (cards.size() <= 0) {
-        return nullptr;
+void Deck::addCards(CardType type, int count) {
+    if (count <= 0) {
+        return;
     }
-    srand((int)time(0));
-    int random(rand() % cards.size());
-    Card* toReturn = cards[random];
-    cards.erase(cards.begin() + random);
-    return toReturn;
+    cardCounts[static_cast<int>(type)] += count;
+    size += count;
 }
 
-Hand::Hand(){
+// picks a card uniformly among all the cards of the deck: a random rank in [0, size) falls in the range of one type
+// the random generator is seeded once per game by the game engine
+bool Deck::draw(CardType &type) {
+    if (size <= 0) {
+        return false;
+    }
+    int random(rand() % size);
+    int i = 0;
+    while (random >= cardCounts[i]) {
+        random -= cardCounts[i];
+        i++;
+    }
+    cardCounts[i]--;
+    size--;
+    type = static_cast<CardType>(i);
+    return true;
 }
 
-Hand::Hand(const vector<Card*> &cards) : hand(cards){
+bool Deck::take(CardType type) {
+    if (cardCounts[static_cast<int>(type)] <= 0) {
+        return false;
+    }
+    cardCounts[static_cast<int>(type)]--;
+    size--;
+    return true;
 }
 
-Hand::Hand(const Hand& h){
-    for (Card* card : h.hand) {
-        this->hand.push_back(new Card(*card));
+Hand::Hand() : size(0){
+    for (int &count : cardCounts) {
+        count = 0;
     }
 }
 
-Hand::~Hand() {
-    for (Card* card : hand) {
-        if(card != nullptr) {
-            delete card;
-            card = nullptr;
-        }
+Hand::Hand(const vector<Card> &cards) : Hand(){
+    for (const Card &card : cards) {
+        cardCounts[static_cast<int>(card.getCardType())]++;
+        size++;
+    }
+}
+
+Hand::Hand(const Hand& h) : size(h.size){
+    for (int i = 0; i < NUM_CARD_TYPES; i++) {
+        cardCounts[i] = h.cardCounts[i];
     }
-    hand.clear();
+}
+
+Hand::~Hand() {
+    // nothing, the hand does not own any card object
 }
 
 Hand& Hand::operator=(const Hand& h){
-    vector<Card*> copyOfHand;
-    for (int i = 0; i < h.hand.size(); i++) {
-        copyOfHand.push_back(new Card(*h.hand[i]));
+    for (int i = 0; i < NUM_CARD_TYPES; i++) {
+        cardCounts[i] = h.cardCounts[i];
     }
-    hand = copyOfHand;
+    size = h.size;
     return *this;
 }
 
@@ -223,79 +280,104 @@ std::ostream& operator<<(std::ostream& stream, const Hand& h){
     return stream << "Hand details, size: " << h.getSize() << endl << "Cards in hand: \n" << h.printHand();
 }
 
-int Hand::getSize() const { return hand.size(); }
+int Hand::getSize() const { return size; }
+
+int Hand::getCount(CardType type) const {
+    return cardCounts[static_cast<int>(type)];
+}
+
+bool Hand::hasCard(CardType type) const {
+    return cardCounts[static_cast<int>(type)] > 0;
+}
 
 string Hand::printHand() const{
-    bool newLine = false;
-    std::ostringstream buffer;
-    if (hand.size() <= 0) {
+    if (size <= 0) {
         return "Hand is empty!\n";
     }
-    for (int i = 0; i < hand.size(); i++) {
-        newLine = false;
-        buffer << "[Card " << (i + 1) << ": " << hand[i]->getType() << "]\t\t";
-        if ((i+1)% 3 == 0) {
-            buffer << "\n";
-            newLine = true;
-        }
+    return printCardCounts(cardCounts);
+}
+
+// type of the card at a position (starting at 1) of the hand, as listed by printHand
+CardType Hand::typeAt(int position) const {
+    int i = 0;
+    while (position > cardCounts[i]) {
+        position -= cardCounts[i];
+        i++;
     }
-    if (!newLine) { buffer << "\n"; }
-    return buffer.str();
+    return static_cast<CardType>(i);
 }
 
 void Hand::drawFromDeck(Deck* deck) {
-    hand.push_back(deck->draw());
+    CardType type;
+    if (deck != nullptr && deck->draw(type)) {
+        cardCounts[static_cast<int>(type)]++;
+        size++;
+    }
+}
+
+bool Hand::takeFromDeck(Deck* deck, CardType type) {
+    if (deck == nullptr || !deck->take(type)) {
+        return false;
+    }
+    cardCounts[static_cast<int>(type)]++;
+    size++;
+    return true;
 }
 
 
 void Hand::playAllCards(Deck* deck, Player *&player) {
-    int size = hand.size();
-    for (int i = 0; i < size; i++) {
-        deck->addCard(hand[0]->play(player));
-        hand.erase(hand.begin());
+    for (int type = 0; type < NUM_CARD_TYPES; type++) {
+        for (; cardCounts[type] > 0; cardCounts[type]--) {
+            Card(static_cast<CardType>(type)).play(player);
+            deck->addCard(static_cast<CardType>(type));
+        }
     }
+    size = 0;
 }
 
 bool Hand::playOneCard(int position, Deck* deck, Player *&player) {
-    if (position > hand.size() || position < 1) {
+    if (position > size || position < 1) {
         cout << "Invalid position entered.\n";
         return false;
     } else {
-        deck->addCard(hand[position-1]->play(player));
-        hand.erase(hand.begin() + position-1);
+        CardType type = typeAt(position);
+        Card(type).play(player);
+        cardCounts[static_cast<int>(type)]--;
+        size--;
+        deck->addCard(type);
         return true;
     }
 
 }
 
-vector<Card *> Hand::getHand() const  {
-    return hand;
+vector<Card> Hand::getHand() const  {
+    vector<Card> cards;
+    for (int type = 0; type < NUM_CARD_TYPES; type++) {
+        for (int i = 0; i < cardCounts[type]; i++) {
+            cards.emplace_back(static_cast<CardType>(type));
+        }
+    }
+    return cards;
 }
 
-void Hand::removeCard(Card *A_card) {
-    for (int i = 0 ; i<hand.size();i++){
-        if (hand.at(i) == A_card){
-            if(GameEngine::deck != nullptr) {
-                GameEngine::deck->addCard(A_card);
-            }
-            hand.erase(hand.begin() + i);
-            break;
-        }
+bool Hand::removeCard(CardType type) {
+    if (!hasCard(type)) {
+        return false;
+    }
+    if(GameEngine::deck != nullptr) {
+        GameEngine::deck->addCard(type);
     }
+    cardCounts[static_cast<int>(type)]--;
+    size--;
+    return true;
 }
 
 void Hand::removeAllCards() {
-    for (int i = 0 ; i < hand.size(); i++){
+    for (int type = 0; type < NUM_CARD_TYPES; type++) {
         if (GameEngine::deck != nullptr){
-            GameEngine::deck->addCard(hand.at(i));
+            GameEngine::deck->addCards(static_cast<CardType>(type), cardCounts[type]);
         }
+        cardCounts[type] = 0;
     }
-    hand.clear();
+    size = 0;
 }
-
-
-
-
-
-
-
@@ -16,11 +16,39 @@ class Order;
 class Card;
 class Territory;
 
+/**
+ * The kinds of cards of the game.
+ * The values are used as indices in the card-count arrays of the deck and the hands.
+ */
+enum class CardType : int {
+    Bomb,
+    Reinforcement,
+    Blockade,
+    Airlift,
+    Diplomacy
+};
+
+const int NUM_CARD_TYPES = 5;
+
+/**
+ * name of a card type, as used in the commands and in the logs ("bomb", "reinforcement", ...)
+ */
+string cardTypeToString(CardType type);
+
+/**
+ * parses the name of a card type
+ * @param name name of the card type
+ * @param type set to the parsed card type on success
+ * @return false if the name is not a valid card type
+ */
+bool stringToCardType(const string &name, CardType &type);
+
 class Card{
 public:
     //constructors and destructors
     Card();
     Card(string type);
+    Card(CardType type);
     ~Card();
 
     //copy constructor and operator overloads
@@ -28,24 +56,26 @@ public:
     Card& operator =(const Card& c);
     friend std::ostream& operator<<(std::ostream& stream, const Card& c);
 
-    Card* play(Player *&player); //play function as per assignment handout
-    void testType(); //guard function for constructor
+    void play(Player *&player); //play function as per assignment handout
     string printCard() const; //for debugging, unused
 
     string getType() const; //accessor
+    CardType getCardType() const; //accessor
     void setType(string typer); //mutator
 
     void useCardtoCreateOrder(Player *player, int numArmies, Territory *source,Territory *target);
 
 private:
-    string type;
+    CardType type;
 };
 
+/**
+ * The deck only keeps how many cards of each type it holds, so drawing, adding and copying never allocate.
+ */
 class Deck{
 public:
     //constructors and destructors
     Deck();
-    Deck(vector<Card*> &cards);
     ~Deck();
 
     //copy constructor and operator overloads
@@ -53,22 +83,41 @@ public:
     Deck& operator =(const Deck& d);
     friend std::ostream& operator<<(std::ostream& stream, const Deck& d);
 
-    void addCard(Card* carder); //adds a card to the deck manually
-    void addCard(string type); //creates a card of the type passed in parameter then adds to deck
-    Card* draw(); //draws a card from the deck as requested from the assignment handout
+    void addCard(CardType type); //returns a card to the deck
+    void addCard(string type); //adds a card of the type passed in parameter to the deck
+    void addCards(CardType type, int count); //adds several cards of the same type to the deck
+
+    /**
+     * draws a random card from the deck, every card having the same chance to be drawn
+     * @param type set to the type of the drawn card
+     * @return false if the deck is empty
+     */
+    bool draw(CardType &type);
+
+    /**
+     * removes a card of a given type from the deck
+     * @return false if the deck holds no card of this type
+     */
+    bool take(CardType type);
 
     int getSize() const; //function to see how big the deck is at the moment
+    int getCount(CardType type) const; //number of cards of a given type in the deck
     string printDeck() const; //function to see all cards in deck, also used in << operator
 
 private:
-    vector<Card*> cards;
+    int cardCounts[NUM_CARD_TYPES];
+    int size;
 };
 
+/**
+ * Like the deck, a hand only keeps how many cards of each type it holds.
+ * Cards are listed, and played by position, grouped by type in the order of CardType.
+ */
 class Hand{
 public:
     //constructors and destructors
     Hand();
-    Hand(const vector<Card*> &cards);
+    Hand(const vector<Card> &cards);
     ~Hand();
 
     //copy constructor and operator overloads
@@ -77,18 +126,23 @@ public:
     friend std::ostream& operator<<(std::ostream& stream, const Hand& h);
 
     void drawFromDeck(Deck* deck); //removes a card randomly from the deck and adds it to the player's hand
+    bool takeFromDeck(Deck* deck, CardType type); //moves a card of a given type from the deck to the hand, false if the deck has none
     void playAllCards(Deck* deck, Player *&player); //plays all cards in the player's hand
     bool playOneCard(int position, Deck* deck, Player *&player); //plays a specific card, use printHand or << operator to find out which cards are at what position
 
     int getSize() const; //function to see the size of the player's hand
+    int getCount(CardType type) const; //number of cards of a given type in the hand
+    bool hasCard(CardType type) const;
     string printHand() const; //prints out all cards on hand
-    vector<Card *> getHand() const;
-    void removeCard(Card * card);
+    vector<Card> getHand() const;
+    bool removeCard(CardType type); //returns a card of the given type to the game's deck
     void removeAllCards();
 
 private:
-    vector<Card*> hand;
+    int cardCounts[NUM_CARD_TYPES];
+    int size;
 
+    CardType typeAt(int position) const;
 };
 
 class DiplomacyCard : public Card
@@ -102,4 +156,4 @@ protected:
     Order* buildOrder_() const;
 };
 
-#endif //COMP345_CARDS_H
\ No newline at end of file
+#endif //COMP345_CARDS_H
@@ -19,16 +19,16 @@ void CardDriver(){
 
     //Testing card constructors and operators
     Deck* cardDeckptr = new Deck();
-    cardDeckptr->addCard(new Card("bomb"));
-    cardDeckptr->addCard(new Card("reinforcement"));
-    cardDeckptr->addCard(new Card("blockade"));
-    cardDeckptr->addCard(new Card("airlift"));
-    cardDeckptr->addCard(new Card("diplomacy"));
-    cardDeckptr->addCard(new Card("bomb"));
-    cardDeckptr->addCard(new Card("reinforcement"));
-    cardDeckptr->addCard(new Card("blockade"));
-    cardDeckptr->addCard(new Card("airlift"));
-    cardDeckptr->addCard(new Card("diplomacy"));
+    cardDeckptr->addCard(string("bomb"));
+    cardDeckptr->addCard(string("reinforcement"));
+    cardDeckptr->addCard(string("blockade"));
+    cardDeckptr->addCard(string("airlift"));
+    cardDeckptr->addCard(string("diplomacy"));
+    cardDeckptr->addCard(string("bomb"));
+    cardDeckptr->addCard(string("reinforcement"));
+    cardDeckptr->addCard(string("blockade"));
+    cardDeckptr->addCard(string("airlift"));
+    cardDeckptr->addCard(string("diplomacy"));
     cout << *cardDeckptr << endl;
 
     Deck* cardDeckCopyptr = new Deck(*cardDeckptr);
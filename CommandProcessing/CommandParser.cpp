@@ -0,0 +1,276 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "CommandParser.h"
+#include "../GameEngine/GameEngine.h"
+#include <cctype>
+#include <climits>
+#include <sstream>
+
+namespace {
+    const CommandSpec COMMAND_SPECS[] = {
+            {"loadmap", ArgumentKind::SINGLE, "Command does not specify a map file.",
+                    2, {Phases::START, Phases::MAPLOADED}, 0, {}},
+            {"validatemap", ArgumentKind::NONE, nullptr,
+                    1, {Phases::MAPLOADED}, 0, {}},
+            {"addplayer", ArgumentKind::SINGLE, "Command does not specify a player's name.",
+                    2, {Phases::MAPVALIDATED, Phases::PLAYERSADDED}, 0, {}},
+            {"gamestart", ArgumentKind::NONE, nullptr,
+                    1, {Phases::PLAYERSADDED}, 0, {}},
+            {"replay", ArgumentKind::NONE, nullptr,
+                    1, {Phases::WIN}, 0, {}},
+            {"quit", ArgumentKind::NONE, nullptr,
+                    1, {Phases::WIN}, 0, {}},
+            // the game engine holds tournaments to 5 maps and 4 strategies unless it plays sweeps
+            {"tournament", ArgumentKind::OPTIONS, nullptr,
+                    1, {Phases::START}, 5, {
+                            {"M", OptionPresence::REQUIRED, OptionKind::LIST, 1, MAX_OPTION_VALUES, "map"},
+                            {"P", OptionPresence::REQUIRED, OptionKind::LIST, 2, 8, "player strategies"},
+                            {"G", OptionPresence::REQUIRED, OptionKind::INTEGER, 1, 1, "number of games"},
+                            {"D", OptionPresence::REQUIRED, OptionKind::INTEGER, 1, 1, "max number of turns"},
+                            {"resume", OptionPresence::STANDALONE, OptionKind::LIST, 1, 1, "checkpoint file"}}},
+            {"stats", ArgumentKind::NONE, nullptr,
+                    0, {}, 0, {}},
+            {"eof", ArgumentKind::NONE, nullptr,
+                    0, {}, 0, {}},
+    };
+
+    const char *PHASE_NAMES[] = {"START", "MAPLOADED", "MAPVALIDATED", "PLAYERSADDED", "ASSIGNREINFORCEMENT",
+                                 "ISSUEORDERS", "EXECUTEORDERS", "WIN"};
+
+    bool isSeparator(char c) {
+        return isspace(static_cast<unsigned char>(c)) || c == ',';
+    }
+
+    // parses a whole number without copying the token, false if a character is not a digit or the number is too large
+    bool parseNumber(const string &line, const Token &token, int &number) {
+        number = 0;
+        for (size_t i = token.position; i < token.position + token.length; i++) {
+            if (!isdigit(static_cast<unsigned char>(line[i])) || number > (INT_MAX - 9) / 10) {
+                return false;
+            }
+            number = number * 10 + (line[i] - '0');
+        }
+        return true;
+    }
+
+    bool fail(string &error, size_t &errorPosition, const string &message, size_t position) {
+        error = message;
+        errorPosition = position;
+        return false;
+    }
+}
+
+/*
+ * Command Tokenizer portion
+ */
+
+CommandTokenizer::CommandTokenizer(const string &line) : line(line), position(0) { }
+
+bool CommandTokenizer::peek(Token &token) const {
+    size_t start = position;
+    while (start < line.length() && isSeparator(line[start])) {
+        start++;
+    }
+    if (start >= line.length()) {
+        return false;
+    }
+    size_t end = start;
+    while (end < line.length() && !isSeparator(line[end])) {
+        end++;
+    }
+    token.position = start;
+    token.length = end - start;
+    return true;
+}
+
+bool CommandTokenizer::next(Token &token) {
+    if (!peek(token)) {
+        position = line.length();
+        return false;
+    }
+    position = token.position + token.length;
+    return true;
+}
+
+string CommandTokenizer::toString(const Token &token) const {
+    return line.substr(token.position, token.length);
+}
+
+bool CommandTokenizer::equalsIgnoreCase(const Token &token, const char *word) const {
+    size_t i = 0;
+    for (; i < token.length && word[i] != '\0'; i++) {
+        if (tolower(static_cast<unsigned char>(line[token.position + i])) != tolower(static_cast<unsigned char>(word[i]))) {
+            return false;
+        }
+    }
+    return i == token.length && word[i] == '\0';
+}
+
+bool CommandTokenizer::isOption(const Token &token) const {
+    return token.length >= 2 && line[token.position] == '-' && isalpha(static_cast<unsigned char>(line[token.position + 1]));
+}
+
+size_t CommandTokenizer::getLineLength() const {
+    return line.length();
+}
+
+/*
+ * Command Parser portion
+ */
+
+const CommandSpec *CommandParser::findSpec(const CommandTokenizer &tokenizer, const Token &word) {
+    for (const CommandSpec &spec : COMMAND_SPECS) {
+        if (tokenizer.equalsIgnoreCase(word, spec.name)) {
+            return &spec;
+        }
+    }
+    return nullptr;
+}
+
+bool CommandParser::isAcceptedIn(const CommandSpec &spec, Phases phase) {
+    if (spec.numPhases == 0) {
+        return true;
+    }
+    for (int i = 0; i < spec.numPhases; i++) {
+        if (spec.phases[i] == phase) {
+            return true;
+        }
+    }
+    return false;
+}
+
+string CommandParser::phasesMessage(const CommandSpec &spec) {
+    std::ostringstream buffer;
+    buffer << spec.name << " is only accepted during the phase" << (spec.numPhases > 1 ? "s " : " ");
+    for (int i = 0; i < spec.numPhases; i++) {
+        if (i > 0) {
+            buffer << (i == spec.numPhases - 1 ? " and " : ", ");
+        }
+        buffer << PHASE_NAMES[static_cast<int>(spec.phases[i])];
+    }
+    buffer << ".";
+    return buffer.str();
+}
+
+string CommandParser::formatError(const string &line, const string &error, size_t errorPosition) {
+    std::ostringstream buffer;
+    buffer << error << " (column " << errorPosition + 1 << ")" << endl;
+    buffer << "    " << line << endl;
+    buffer << "    " << string(errorPosition, ' ') << "^";
+    return buffer.str();
+}
+
+bool CommandParser::parse(const string &line, ParsedCommand &parsed, string &error, size_t &errorPosition) {
+    CommandTokenizer tokenizer(line);
+    Token token;
+    parsed.spec = nullptr;
+    if (!tokenizer.next(parsed.word)) {
+        return fail(error, errorPosition, "The command entered was not recognized.", 0);
+    }
+    parsed.spec = findSpec(tokenizer, parsed.word);
+    if (parsed.spec == nullptr) {
+        return fail(error, errorPosition, "The command entered was not recognized.", parsed.word.position);
+    }
+    const CommandSpec &spec = *parsed.spec;
+    size_t end = parsed.word.position + parsed.word.length;
+    parsed.argument = {end, 0};
+
+    if (spec.argumentKind == ArgumentKind::SINGLE) {
+        if (!tokenizer.next(parsed.argument)) {
+            return fail(error, errorPosition, spec.missingArgument, end);
+        }
+    } else if (spec.argumentKind == ArgumentKind::OPTIONS) {
+        ParsedOption *current = nullptr;
+        const OptionSpec *currentSpec = nullptr;
+        size_t currentPosition = 0;
+        for (int i = 0; i < spec.numOptions; i++) {
+            parsed.options[i].provided = false;
+            parsed.options[i].numValues = 0;
+            parsed.options[i].number = 0;
+        }
+        if (tokenizer.peek(token)) {
+            parsed.argument.position = token.position;
+        }
+
+        // an option ends where the next one starts, its values are checked against its spec at that point
+        while (true) {
+            bool more = tokenizer.next(token);
+            if (current != nullptr && (!more || tokenizer.isOption(token))) {
+                if (current->numValues < currentSpec->minValues) {
+                    string message = current->numValues == 0
+                            ? string("No value was specified for the ") + currentSpec->name + " argument of the " + spec.name + " command."
+                            : string("Less than ") + to_string(currentSpec->minValues) + " values were given for the " + currentSpec->name + " argument of the " + spec.name + " command.";
+                    return fail(error, errorPosition, message, currentPosition);
+                }
+                if (currentSpec->kind == OptionKind::INTEGER && !parseNumber(line, current->values[0], current->number)) {
+                    return fail(error, errorPosition, string("The number specified for the ") + currentSpec->name + " argument of the " + spec.name + " command was not a whole number.", current->values[0].position);
+                }
+                current = nullptr;
+            }
+            if (!more) {
+                break;
+            }
+            parsed.argument.length = token.position + token.length - parsed.argument.position;
+
+            if (tokenizer.isOption(token)) {
+                Token flag = {token.position + 1, token.length - 1};
+                int index = -1;
+                for (int i = 0; i < spec.numOptions; i++) {
+                    if (tokenizer.equalsIgnoreCase(flag, spec.options[i].flag)) {
+                        index = i;
+                    }
+                }
+                if (index < 0) {
+                    return fail(error, errorPosition, string("An unexpected argument was found while reading through the ") + spec.name + " command.", token.position);
+                }
+                if (parsed.options[index].provided) {
+                    return fail(error, errorPosition, string("There were more than one -") + spec.options[index].flag + " arguments provided in the " + spec.name + " command.", token.position);
+                }
+                current = &parsed.options[index];
+                currentSpec = &spec.options[index];
+                currentPosition = token.position;
+                current->provided = true;
+            } else if (current == nullptr) {
+                return fail(error, errorPosition, string("An unexpected argument was found while reading through the ") + spec.name + " command.", token.position);
+            } else if (current->numValues == currentSpec->maxValues) {
+                string message = currentSpec->kind == OptionKind::INTEGER
+                        ? string("More than one number was specified for the ") + currentSpec->name + " argument of the " + spec.name + " command."
+                        : string("More than ") + to_string(currentSpec->maxValues) + " values were given for the " + currentSpec->name + " argument of the " + spec.name + " command.";
+                return fail(error, errorPosition, message, token.position);
+            } else {
+                current->values[current->numValues++] = token;
+            }
+        }
+
+        // a standalone option replaces all the others, otherwise every required option must be there
+        const OptionSpec *standalone = nullptr;
+        int numProvided = 0;
+        for (int i = 0; i < spec.numOptions; i++) {
+            if (parsed.options[i].provided) {
+                numProvided++;
+                if (spec.options[i].presence == OptionPresence::STANDALONE) {
+                    standalone = &spec.options[i];
+                }
+            }
+        }
+        if (standalone != nullptr) {
+            if (numProvided > 1) {
+                return fail(error, errorPosition, string("The -") + standalone->flag + " argument of the " + spec.name + " command cannot be combined with other arguments.", parsed.argument.position);
+            }
+            return true;
+        }
+        for (int i = 0; i < spec.numOptions; i++) {
+            if (!parsed.options[i].provided && spec.options[i].presence == OptionPresence::REQUIRED) {
+                return fail(error, errorPosition, string("The ") + spec.name + " command is missing the -" + spec.options[i].flag + " argument.", line.length());
+            }
+        }
+        return true;
+    }
+
+    if (tokenizer.next(token)) {
+        return fail(error, errorPosition, string("An unexpected argument was found while reading through the ") + spec.name + " command.", token.position);
+    }
+    return true;
+}
@@ -0,0 +1,117 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#ifndef COMP345_N11_COMMANDPARSER_H
+#define COMP345_N11_COMMANDPARSER_H
+
+#include <string>
+#include <cstddef>
+using namespace std;
+
+enum class Phases;
+
+/**
+ * A token of a command line, kept as a position and a length in the line instead of a copy of its characters.
+ */
+struct Token {
+    size_t position;
+    size_t length;
+};
+
+/**
+ * Splits a command line into tokens, one token at a time and without allocating.
+ * Tokens are separated by white spaces and commas, so "-P Aggressive, Cheater" gives the tokens "-P", "Aggressive" and "Cheater".
+ * The tokenizer keeps a reference to the line, which must outlive it.
+ */
+class CommandTokenizer {
+public:
+    explicit CommandTokenizer(const string &line);
+
+    bool next(Token &token); //reads the next token, returns false at the end of the line
+    bool peek(Token &token) const; //same as next, without moving forward
+
+    string toString(const Token &token) const; //copies the characters of a token
+    bool equalsIgnoreCase(const Token &token, const char *word) const;
+    bool isOption(const Token &token) const; //a '-' followed by a letter, e.g. "-M"
+    size_t getLineLength() const;
+
+private:
+    const string &line;
+    size_t position;
+};
+
+/**
+ * Declarative description of the commands accepted by the command processor.
+ */
+enum class OptionKind {LIST, INTEGER};
+enum class ArgumentKind {NONE, SINGLE, OPTIONS};
+enum class OptionPresence {
+    REQUIRED,
+    OPTIONAL,
+    STANDALONE //given alone, in place of all the other options
+};
+
+const int MAX_OPTION_VALUES = 64;
+const int MAX_COMMAND_OPTIONS = 6;
+const int MAX_COMMAND_PHASES = 2;
+
+struct OptionSpec {
+    const char *flag; //word following the '-', case insensitive, e.g. "M" or "resume"
+    OptionPresence presence;
+    OptionKind kind;
+    int minValues;
+    int maxValues; //at most MAX_OPTION_VALUES
+    const char *name; //used in error messages
+};
+
+struct CommandSpec {
+    const char *name;
+    ArgumentKind argumentKind;
+    const char *missingArgument; //error message when a SINGLE argument is missing
+    int numPhases; //0 when the command is accepted in every phase
+    Phases phases[MAX_COMMAND_PHASES];
+    int numOptions;
+    OptionSpec options[MAX_COMMAND_OPTIONS];
+};
+
+/**
+ * Result of parsing a command line against its schema. Values are tokens of the parsed line, nothing is copied.
+ */
+struct ParsedOption {
+    bool provided;
+    int numValues;
+    Token values[MAX_OPTION_VALUES];
+    int number; //value of an INTEGER option
+};
+
+struct ParsedCommand {
+    const CommandSpec *spec;
+    Token word;
+    Token argument; //SINGLE commands: the argument, OPTIONS commands: everything after the command word
+    ParsedOption options[MAX_COMMAND_OPTIONS];
+};
+
+class CommandParser {
+public:
+    /**
+     * tokenizes a command line and checks it against the schema of its command
+     * @param line the command line
+     * @param parsed filled with the command spec and the tokens of the arguments
+     * @param error set to the error message when the line is rejected
+     * @param errorPosition set to the position in the line of the token causing the error
+     * @return true if the line matches the schema of a known command
+     */
+    static bool parse(const string &line, ParsedCommand &parsed, string &error, size_t &errorPosition);
+
+    static const CommandSpec *findSpec(const CommandTokenizer &tokenizer, const Token &word);
+    static bool isAcceptedIn(const CommandSpec &spec, Phases phase);
+    static string phasesMessage(const CommandSpec &spec); //e.g. "loadmap is only accepted during the phases START and MAPLOADED."
+
+    /**
+     * console friendly error: the message, then the line with a caret under the faulty position
+     */
+    static string formatError(const string &line, const string &error, size_t errorPosition);
+};
+
+#endif //COMP345_N11_COMMANDPARSER_H
@@ -3,6 +3,7 @@
 //
 
 #include "CommandProcessing.h"
+#include "CommandParser.h"
 #include <sstream>
 #include <string>
 
@@ -39,7 +40,7 @@ Command::Command(string command, string effect, string instruction, string argum
  * copy constructor, copies all details
  * @param c command object to be copied
  */
-Command::Command(const Command& c) {
+Command::Command(const Command& c) : Subject(c) {
     this->command = c.command;
     this->effect = c.effect;
     this->instruction = c.instruction;
@@ -81,8 +82,10 @@ void Command::saveEffect(string effect) {
     this->effect = effect;
 
     // for Iloggable
-    this->contentToLog = effect;
-    notify();
+    if (isObserved()) {
+        this->contentToLog = effect;
+        notify();
+    }
 }
 
 string Command::getEffect() {
@@ -142,32 +145,45 @@ int Command::getNumOfTurns() {
     return this->numOfTurns;
 }
 
+string Command::getResumeFile() {
+    return this->resumeFile;
+}
+
+void Command::setResumeFile(string resumeFile) {
+    this->resumeFile = resumeFile;
+}
+
 /*
  * Command Processor portion
  */
 
-CommandProcessor::CommandProcessor() { }
+CommandProcessor::CommandProcessor() : historyLimit(0) { }
 
 /**
- * destructor will delete all command objects in the collection
+ * copy constructor, copies list of Commands
  */
-CommandProcessor::~CommandProcessor() {
-    for (Command* com : commandList) {
-        delete com;
-        com = NULL;
+CommandProcessor::CommandProcessor(const CommandProcessor& c) : Subject(c), historyLimit(c.historyLimit) {
+    for (const auto &command : c.commandList) {
+        commandList.emplace_back(new Command(*command));
     }
-    commandList.erase(commandList.begin(), commandList.end());
 }
 
+/**
+ * destructor, the command objects in the collection are deleted with it
+ */
+CommandProcessor::~CommandProcessor() = default;
+
 /**
  * assignment operator, copies list of Commands
  */
 CommandProcessor& CommandProcessor::operator=(const CommandProcessor& c) {
-    vector<Command*> copyOfCommands;
-    for (int i = 0; i < c.commandList.size(); i++) {
-        copyOfCommands.push_back(new Command(*c.commandList[i]));
+    if (this != &c) {
+        commandList.clear();
+        for (const auto &command : c.commandList) {
+            commandList.emplace_back(new Command(*command));
+        }
+        historyLimit = c.historyLimit;
     }
-    commandList = copyOfCommands;
     return *this;
 }
 
@@ -190,7 +206,19 @@ Command* CommandProcessor::getCommand() {
  * @return vector of pointers of commands
  */
 vector<Command*> CommandProcessor::getCommandList() {
-    return commandList;
+    vector<Command*> commands;
+    for (const auto &command : commandList) {
+        commands.push_back(command.get());
+    }
+    return commands;
+}
+
+void CommandProcessor::setHistoryLimit(size_t historyLimit) {
+    this->historyLimit = historyLimit;
+}
+
+size_t CommandProcessor::getHistoryLimit() const {
+    return historyLimit;
 }
 
 /**
@@ -198,7 +226,7 @@ vector<Command*> CommandProcessor::getCommandList() {
  * @return returns pointer to the last command in the list of commands
  */
 Command* CommandProcessor::getLastCommandInList() {
-    return commandList.back();
+    return commandList.back().get();
 }
 
 /**
@@ -237,321 +265,72 @@ std::string trim(const std::string &s) {
 
 /**
  * validate function to verify that the command entered is valid for the game state the game is in
+ * The command line is checked against the schema of its command by the CommandParser, which points at the faulty token
+ * when the line is rejected.
  * @param command a command object we are testing for valid existing command + valid game state to execute in
  * @param phase the current state of the game
  * @return true or false to indicate whether the command entered was valid for the game state
  */
 bool CommandProcessor::validate(Command* command, Phases* phase) {
     string commander = command->getCommand();
-    stringstream ss(commander);
-    string comWord, comArg;
-    ss >> comWord; //get first token of input string
-    if(comWord == "loadmap" || comWord == "addplayer" || comWord == "tournament") {
-        ss >> comArg;
+    ParsedCommand parsed;
+    string error;
+    size_t errorPosition;
+    if (!CommandParser::parse(commander, parsed, error, errorPosition)) {
+        cout << CommandParser::formatError(commander, error, errorPosition) << endl;
+        command->saveEffect(error);
+        return false;
     }
-    std::transform(comWord.begin(), comWord.end(), comWord.begin(),
-                   [](unsigned char c){ return std::tolower(c); }); //convert input to lowercase for easier handling
-    if (comWord.compare("loadmap") == 0) {
-        if ((*phase != Phases::START && *phase != Phases::MAPLOADED) || comArg.empty()) {
-            if(comArg.empty()) {
-                cout << "loadmap needs an argument." << endl;
-                command->saveEffect("Command does not specify a map file.");
-            } else {
-                cout << "loadmap is only accepted during the phases START and MAPLOADED." << endl;
-                command->saveEffect("Unable to proceed with the command at the current game state.");
-            }
-            return false;
-        } else {
-            command->setInstruction(comWord);
-            command->setArgument(comArg);
-            return true;
-        }
-    } else if (comWord.compare("validatemap") == 0) {
-        if (*phase != Phases::MAPLOADED) {
-            cout << "validatemap is only accepted during the phase MAPLOADED." << endl;
-            command->saveEffect("Unable to proceed with the command at the current game state.");
-            return false;
-        } else {
-            command->setInstruction(comWord);
-            return true;
-        }
-    } else if (comWord.compare("addplayer") == 0) {
-        if ((*phase != Phases::PLAYERSADDED && *phase != Phases::MAPVALIDATED) || comArg.empty()) {
-            if(comArg.empty()) {
-                cout << "A player needs a name." << endl;
-                command->saveEffect("Command does not specify a player's name.");
-            } else {
-                cout << "addplayer is only accepted during the phases MAPVALIDATED and PLAYERSADDED." << endl;
-                command->saveEffect("Unable to proceed with the command at the current game state.");
-            }
-            return false;
-        } else {
-            command->setInstruction(comWord);
-            command->setArgument(comArg);
-            return true;
-        }
-    } else if (comWord.compare("gamestart") == 0) {
-        if (*phase != Phases::PLAYERSADDED) {
-            cout << "gamestart is only accepted during the phase PLAYERSADDED."<< endl;
-            command->saveEffect("Unable to proceed with the command at the current game state.");
-            return false;
-        } else {
-            command->setInstruction(comWord);
-            return true;
-        }
-    } else if (comWord.compare("replay") == 0) {
-        if (*phase != Phases::WIN) {
-            cout << "replay is only accepted during the phase WIN."<< endl;
-            command->saveEffect("Unable to proceed with the command at the current game state.");
-            return false;
-        } else {
-            command->setInstruction(comWord);
-            return true;
+    const CommandSpec &spec = *parsed.spec;
+    if (!CommandParser::isAcceptedIn(spec, *phase)) {
+        cout << CommandParser::phasesMessage(spec) << endl;
+        command->saveEffect("Unable to proceed with the command at the current game state.");
+        return false;
+    }
+
+    CommandTokenizer tokenizer(commander);
+    if (spec.argumentKind == ArgumentKind::OPTIONS) {
+        // tournament: the options are, in the order of the schema, -M maps, -P player strategies, -G games and -D turns,
+        // or -resume alone
+        if (parsed.options[4].provided) {
+            command->setResumeFile(tokenizer.toString(parsed.options[4].values[0]));
         }
-    } else if (comWord.compare("quit") == 0) {
-        if (*phase != Phases::WIN) {
-            cout << "quit is only accepted during the phase WIN."<< endl;
-            command->saveEffect("Unable to proceed with the command at the current game state.");
-            return false;
-        } else {
-            command->setInstruction(comWord);
-            return true;
+        vector<string> mapList;
+        for (int i = 0; i < parsed.options[0].numValues; i++) {
+            mapList.push_back(tokenizer.toString(parsed.options[0].values[i]));
         }
-    } else if (comWord.compare("tournament") == 0) {
-        if (*phase != Phases::START) {
-            cout << "tournament is only accepted during the phase START."<< endl;
-            command->saveEffect("Unable to proceed with the command at the current game state.");
-            return false;
-        } else {
-            command->setInstruction(comWord);
-            comArg = commander.substr(11);
-            stringstream strs( comArg );
-
-            bool mapProvided = false;
-            bool playerStrategiesProvided = false;
-            bool gamesProvided = false;
-            bool turnsProvided = false;
-
-            vector<string> mapList;
-            int mapCounter = 0;
-            vector<string> playerStrategiesList;
-            int playerStrategiesCounter = 0;
-
-            int numOfGames;
-            int numOfTurns;
-
-            while( strs.good() ) //loop through the argument part of the command to extract inputs
-            {
-                string substr;
-                getline( strs, substr, '-' );
-                if (substr[0] == 'M' || substr[0] == 'm') { //map argument
-                    if (mapProvided == true) {
-                        cout << "There were more than one -M arguments provided in the tournament command." << endl;
-                        command->saveEffect("There were more than one -M arguments provided in the tournament command.");
-                        return false;
-                    }
-                    stringstream ssMap(substr.substr(1));
-                    string substrMap;
-                    ssMap >> substrMap; //extracting first map (there will be at least one map always)
-                    if (substrMap.find('-') != std::string::npos || substrMap == "") {
-                        cout << "No maps were specified for the map argument of the tournament command. " << endl;
-                        command->saveEffect("No maps were specified for the map argument of the tournament command.");
-                        return false;
-                    }
-                    substrMap = trim(substrMap);
-                    substrMap.erase(std::remove(substrMap.begin(), substrMap.end(), ','), substrMap.end());
-                    mapList.push_back(substrMap);
-                    mapCounter += 1;
-                    while (ssMap.good()) { //extracting additional maps
-                        getline( ssMap, substrMap, ',' );
-                        substrMap = trim(substrMap);
-                        if (substrMap == "") continue;
-                        mapList.push_back(substrMap);
-                        mapCounter += 1;
-                        if (mapCounter > 5) {
-                            cout << "More than 5 maps were given in the map argument of the tournament command. " << endl;
-                            command->saveEffect("More than 5 maps were given in the map argument of the tournament command. ");
-                            return false;
-                        }
-                    }
-                    command->setMapList(mapList);
-                    mapProvided = true;
-                } else if (substr[0] == 'P' || substr[0] == 'p') { //player strategies argument
-                    if (playerStrategiesProvided == true) {
-                        cout << "There were more than one -P arguments provided in the tournament command." << endl;
-                        command->saveEffect("There were more than one -P arguments provided in the tournament command.");
-                        return false;
-                    }
-                    stringstream ssPlayerStrats(substr.substr(1));
-                    string substrPStrats;
-                    ssPlayerStrats >> substrPStrats; //extracting first player strat (there will be at least one map always)
-                    if (substrPStrats.find('-') != std::string::npos || substrPStrats == "") {
-                        cout << "No player strategies were specified for the player stategies argument of the tournament command. " << endl;
-                        command->saveEffect("No player stategies were specified for the player stategies argument of the tournament command.");
-                        return false;
-                    }
-                    substrPStrats = trim(substrPStrats);
-                    substrPStrats.erase(std::remove(substrPStrats.begin(), substrPStrats.end(), ','), substrPStrats.end());
-                    string validStrat = substrPStrats;
-                    std::transform(validStrat.begin(), validStrat.end(), validStrat.begin(),
-                                   [](unsigned char c){ return std::tolower(c); }); //convert input to lowercase for easier handling
-                    if (validStrat.compare("human") == 0) {
-                        cout << "A player strategy may not be 'human' for the tournament command. " << endl;
-                        command->saveEffect("A player strategy may not be 'human' for the tournament command. ");
-                        return false;
-                    } else if (validStrat.compare("neutral") != 0 && validStrat.compare("benevolent") != 0 && validStrat.compare("aggressive") != 0 && validStrat.compare("cheater") != 0) {
-                        cout << "An invalid player strategy was entered for the tournament command. " << endl;
-                        command->saveEffect("An invalid player strategy was entered for the tournament command. ");
-                        return false;
-                    }
-                    validStrat[0] = toupper(validStrat[0]);
-                    playerStrategiesList.push_back(validStrat);
-                    playerStrategiesCounter += 1;
-                    while (ssPlayerStrats.good()) { //extracting additional player strats
-                        getline( ssPlayerStrats, substrPStrats, ',' );
-                        substrPStrats = trim(substrPStrats);
-                        if (substrPStrats == "") continue;
-                        string validStrat = substrPStrats;
-                        std::transform(validStrat.begin(), validStrat.end(), validStrat.begin(),
-                                       [](unsigned char c){ return std::tolower(c); }); //convert input to lowercase for easier handling
-                        if (validStrat.compare("human") == 0) {
-                            cout << "A player strategy may not be 'human' for the tournament command. " << endl;
-                            command->saveEffect("A player strategy may not be 'human' for the tournament command. ");
-                            return false;
-                        } else if (validStrat.compare("neutral") != 0 && validStrat.compare("benevolent") != 0 && validStrat.compare("aggressive") != 0 && validStrat.compare("cheater") != 0) {
-                            cout << "An invalid player strategy was entered for the tournament command. " << endl;
-                            command->saveEffect("An invalid player strategy was entered for the tournament command. ");
-                            return false;
-                        }
-                        validStrat[0] = toupper(validStrat[0]);
-                        playerStrategiesList.push_back(validStrat);
-                        playerStrategiesCounter += 1;
-                        if (playerStrategiesCounter > 4) {
-                            cout << "More than 4 player stategies were given in the map argument of the tournament command. " << endl;
-                            command->saveEffect("More than 4 player stategies were given in the map argument of the tournament command. ");
-                            return false;
-                        }
-                    }
-                    if (playerStrategiesCounter < 2) {
-                        cout << "Less than 2 player stategies were given in the map argument of the tournament command. " << endl;
-                        command->saveEffect("Less than 2 player stategies were given in the map argument of the tournament command. ");
-                        return false;
-                    }
-                    command->setplayerStrategiesList(playerStrategiesList);
-                    playerStrategiesProvided = true;
-                } else if (substr[0] == 'G' || substr[0] == 'g') { //games argument
-                    if (gamesProvided == true) {
-                        cout << "There were more than one -G arguments provided in the tournament command." << endl;
-                        command->saveEffect("There were more than one -G arguments provided in the tournament command.");
-                        return false;
-                    }
-                    stringstream ssGames(substr.substr(1));
-                    string substrNum;
-                    getline( ssGames, substrNum, '-' ); //extracting games
-                    substrNum = trim(substrNum);
-                    if (substrNum.find('-') != std::string::npos || substrNum == "") {
-                        cout << "No number was specified for the number of games argument of the tournament command. " << endl;
-                        command->saveEffect("No number was specified for the number of games argument of the tournament command. ");
-                        return false;
-                    } else if (substrNum.find(' ') != std::string::npos) {
-                        cout << "More than one number was specified for the number of games argument of the tournament command. " << endl;
-                        command->saveEffect("More than one number was specified for the number of games argument of the tournament command. ");
-                        return false;
-                    } else if (substrNum.find('.') != std::string::npos) {
-                        cout << "The number specified for the number of games argument of the tournament command was not a whole number." << endl;
-                        command->saveEffect("The number specified for the number of games argument of the tournament command was not a whole number. ");
-                        return false;
-                    }
-                    try {
-                        numOfGames = std::stoi(substrNum); //parse int from string
-                    }
-                    catch(exception &err)
-                    {
-                        cout << "No number was specified for the number of games argument of the tournament command. " << endl;
-                        command->saveEffect("No number was specified for the number of games argument of the tournament command. ");
-                        return false;
-                    }
-                    command->setNumOfGames(numOfGames);
-                    gamesProvided = true;
-                } else if (substr[0] == 'D' || substr[0] == 'd') { //duration argument
-                    if (turnsProvided == true) {
-                        cout << "There were more than one -D arguments provided in the tournament command." << endl;
-                        command->saveEffect("There were more than one -D arguments provided in the tournament command.");
-                        return false;
-                    }
-                    stringstream ssDuration(substr.substr(1));
-                    string substrNum;
-                    getline( ssDuration, substrNum, '-' ); //extracting games
-                    substrNum = trim(substrNum);
-                    if (substrNum.find('-') != std::string::npos || substrNum == "") {
-                        cout << "No valid number was specified for the max number of turns argument of the tournament command. "
-                             << endl;
-                        command->saveEffect(
-                                "No valid number was specified for the max number of turns argument of the tournament command. ");
-                        return false;
-                    }  else if (substrNum.find(' ') != std::string::npos) {
-                        cout << "More than one number was specified for the max number of turns argument of the tournament command. " << endl;
-                        command->saveEffect("More than one number was specified for the max number of turns argument of the tournament command. ");
-                        return false;
-                    } else if (substrNum.find('.') != std::string::npos) {
-                        cout << "The number specified for the max number of turns argument of the tournament command was not a whole number." << endl;
-                        command->saveEffect("The number specified for the max number of turns argument of the tournament command was not a whole number. ");
-                        return false;
-                    }
-                    try {
-                        numOfTurns = std::stoi(substrNum); //parse int from string
-                    }
-                    catch (exception &err) {
-                        cout << "No number was specified for the max number of turns argument of the tournament command. "
-                             << endl;
-                        command->saveEffect(
-                                "No number was specified for the max number of turns argument of the tournament command. ");
-                        return false;
-                    }
-                    command->setNumOfTurns(numOfTurns);
-                    turnsProvided = true;
-                } else if (substr.length() > 0) {
-                    cout << "An unexpected argument was found while reading through the tournament command."
-                         << endl;
-                    command->saveEffect(
-                            "An unexpected argument was found while reading through the tournament command.");
-                    return false;
-                }
-            }
 
-            if (turnsProvided == false) {
-                cout << "The tournament command is missing the -D argument. " << endl;
-                command->saveEffect(
-                        "The tournament command is missing the -D argument.");
-                return false;
-            } else if (gamesProvided == false) {
-                cout << "The tournament command is missing the -G argument. " << endl;
-                command->saveEffect(
-                        "The tournament command is missing the -G argument.");
-                return false;
-            } else if (mapProvided == false) {
-                cout << "The tournament command is missing the -M argument. " << endl;
-                command->saveEffect(
-                        "The tournament command is missing the -M argument.");
-                return false;
-            } else if (playerStrategiesProvided == false) {
-                cout << "The tournament command is missing the -P argument. " << endl;
-                command->saveEffect(
-                        "The tournament command is missing the -P argument.");
+        vector<string> playerStrategiesList;
+        for (int i = 0; i < parsed.options[1].numValues; i++) {
+            const Token &strategy = parsed.options[1].values[i];
+            if (tokenizer.equalsIgnoreCase(strategy, "human")) {
+                error = "A player strategy may not be 'human' for the tournament command.";
+            } else if (!tokenizer.equalsIgnoreCase(strategy, "neutral") && !tokenizer.equalsIgnoreCase(strategy, "benevolent") &&
+                       !tokenizer.equalsIgnoreCase(strategy, "aggressive") && !tokenizer.equalsIgnoreCase(strategy, "cheater")) {
+                error = "An invalid player strategy was entered for the tournament command.";
+            }
+            if (!error.empty()) {
+                cout << CommandParser::formatError(commander, error, strategy.position) << endl;
+                command->saveEffect(error);
                 return false;
             }
-
-            command->setArgument(comArg);
-            return true;
+            string validStrat = tokenizer.toString(strategy);
+            std::transform(validStrat.begin(), validStrat.end(), validStrat.begin(),
+                           [](unsigned char c){ return std::tolower(c); }); //convert input to lowercase for easier handling
+            validStrat[0] = toupper(validStrat[0]);
+            playerStrategiesList.push_back(validStrat);
         }
-    } else if (comWord.compare("eof") == 0) {
-        command->setInstruction(comWord);
-        return true;
-    } else {
-        cout << "The command entered was not recognized." << endl;
-        command->saveEffect("The command entered was not recognized. ");
-        return false;
+
+        command->setMapList(mapList);
+        command->setplayerStrategiesList(playerStrategiesList);
+        command->setNumOfGames(parsed.options[2].number);
+        command->setNumOfTurns(parsed.options[3].number);
+    }
+    command->setInstruction(spec.name);
+    if (spec.argumentKind != ArgumentKind::NONE) {
+        command->setArgument(tokenizer.toString(parsed.argument));
     }
+    return true;
 }
 
 /**
@@ -561,11 +340,19 @@ bool CommandProcessor::validate(Command* command, Phases* phase) {
 void CommandProcessor::saveCommand(string command) {
     Command* commandObj = new Command();
     commandObj->setCommand(command);
-    commandList.push_back(commandObj);
+    commandList.emplace_back(commandObj);
+
+    // bounded history: the oldest commands are dropped, the list never grows past the limit
+    if (historyLimit > 0 && commandList.size() > historyLimit) {
+        size_t numDropped = commandList.size() - historyLimit;
+        commandList.erase(commandList.begin(), commandList.begin() + numDropped);
+    }
 
     // for Iloggable
-    contentToLog = command;
-    notify();
+    if (isObserved()) {
+        contentToLog = command;
+        notify();
+    }
 }
 
 /*
@@ -574,14 +361,25 @@ void CommandProcessor::saveCommand(string command) {
 
 FileLineReader::FileLineReader() {
     _ifstr = nullptr;
+    chunkSize = DEFAULT_CHUNK_SIZE;
+    bufferPosition = 0;
 } //zero initialization
 
 /**
  * Initializes the file stream to read from the text file in the parameter
  * @param filename name of the text file to read
  */
-FileLineReader::FileLineReader(string filename) {
+FileLineReader::FileLineReader(string filename) : FileLineReader(filename, DEFAULT_CHUNK_SIZE) { }
+
+/**
+ * Initializes the file stream to read from the text file in the parameter
+ * @param filename name of the text file to read
+ * @param chunkSize number of bytes read from the file at a time
+ */
+FileLineReader::FileLineReader(string filename, size_t chunkSize) {
     this->filename = filename;
+    this->chunkSize = chunkSize > 0 ? chunkSize : DEFAULT_CHUNK_SIZE;
+    bufferPosition = 0;
     _ifstr = new fstream();
     _ifstr->open(filename, ios::in);
     if (!_ifstr->is_open()) { //Checks to see if file is open, if not, aborts program.
@@ -607,6 +405,25 @@ FileLineReader::~FileLineReader() {
  */
 void FileLineReader::setFStr(fstream* ifstr) {
     _ifstr = ifstr;
+    buffer.clear();
+    bufferPosition = 0;
+}
+
+/**
+ * appends the next chunk of the file to the buffer, after dropping the lines already read
+ * @return false if there was nothing left to read
+ */
+bool FileLineReader::fillBuffer() {
+    if (_ifstr == nullptr || !_ifstr->good()) {
+        return false;
+    }
+    buffer.erase(0, bufferPosition);
+    bufferPosition = 0;
+    size_t oldSize = buffer.size();
+    buffer.resize(oldSize + chunkSize);
+    _ifstr->read(&buffer[oldSize], chunkSize);
+    buffer.resize(oldSize + _ifstr->gcount());
+    return _ifstr->gcount() > 0;
 }
 
 /**
@@ -614,14 +431,31 @@ void FileLineReader::setFStr(fstream* ifstr) {
  * @return true if a line was read, false if there was no line to read
  */
 bool FileLineReader::readFromLine() {
-    string lineBeingRead;
-    if (_ifstr->eof()) {
-        return false;
+    size_t endOfLine = buffer.find('\n', bufferPosition);
+    while (endOfLine == string::npos) {
+        size_t searchFrom = buffer.size() - bufferPosition;
+        if (!fillBuffer()) {
+            break;
+        }
+        endOfLine = buffer.find('\n', searchFrom);
+    }
+    if (endOfLine == string::npos) {
+        if (bufferPosition >= buffer.size()) {
+            return false;
+        }
+        endOfLine = buffer.size(); //last line of the file, without a line break
+    }
+
+    // trims the line while copying it, reusing the storage of the previous line
+    size_t start = buffer.find_first_not_of(WHITESPACE, bufferPosition);
+    size_t end = buffer.find_last_not_of(WHITESPACE, endOfLine == 0 ? 0 : endOfLine - 1);
+    if (start == string::npos || start >= endOfLine || end == string::npos || end < start) {
+        currentLine.clear();
     } else {
-        getline(*_ifstr,lineBeingRead);
-        currentLine = trim(lineBeingRead);
-        return true;
+        currentLine.assign(buffer, start, end - start + 1);
     }
+    bufferPosition = endOfLine + 1;
+    return true;
 }
 
 /**
@@ -644,6 +478,9 @@ FileCommandProcessorAdapter::FileCommandProcessorAdapter() {
     flr = nullptr;
     comPro = new CommandProcessor();
     usingConsole = true;
+    streaming = false;
+    statsReported = false;
+    numCommandsRead = 0;
 }
 
 /**
@@ -655,12 +492,34 @@ FileCommandProcessorAdapter::FileCommandProcessorAdapter(string filename) {
     flr = new FileLineReader(filename);
     comPro = nullptr;
     usingConsole = false;
+    streaming = false;
+    statsReported = false;
+    numCommandsRead = 0;
+}
+
+/**
+ * Streaming replay constructor, for long command scripts such as automated regression games.
+ * @param filename file path of the text file to be read
+ * @param historyLimit maximum number of commands kept in the list of commands
+ */
+FileCommandProcessorAdapter::FileCommandProcessorAdapter(string filename, size_t historyLimit) {
+    flr = new FileLineReader(filename, STREAMING_CHUNK_SIZE);
+    comPro = nullptr;
+    usingConsole = false;
+    streaming = true;
+    statsReported = false;
+    numCommandsRead = 0;
+    setHistoryLimit(historyLimit);
 }
 
 /**
  * Destructor
  */
 FileCommandProcessorAdapter::~FileCommandProcessorAdapter() {
+    // a replay stopped by a quit command never reaches the end of the script
+    if (streaming && !statsReported) {
+        reportStats();
+    }
     if (flr != nullptr) {
         delete flr;
         flr = nullptr;
@@ -687,6 +546,14 @@ Command* FileCommandProcessorAdapter::getCommand() {
     }
 }
 
+// the commands read from the console are kept by the console processor
+void FileCommandProcessorAdapter::setHistoryLimit(size_t historyLimit) {
+    CommandProcessor::setHistoryLimit(historyLimit);
+    if (comPro != nullptr) {
+        comPro->setHistoryLimit(historyLimit);
+    }
+}
+
 /**
  * Adapter pattern: a different version from the console class that is only called when the input comes from a file
  * protected method that calls the file reader class to retrieve commands from the specified file at the constructor
@@ -694,15 +561,49 @@ Command* FileCommandProcessorAdapter::getCommand() {
  */
 string FileCommandProcessorAdapter::readCommand() {
     if (flr->readFromLine()) {
-        string commander = flr->getCurrentLine();
-        cout << commander << " has been read from the file." << endl;
-        return commander;
+        if (numCommandsRead == 0) {
+            firstRead = chrono::steady_clock::now();
+        }
+        numCommandsRead++;
+        if (!streaming) {
+            cout << flr->getCurrentLine() << " has been read from the file." << endl;
+        }
+        return flr->getCurrentLine();
     } else {
         cout << "There are no more commands to be read from the file." << endl;
+        if (streaming && !statsReported) {
+            reportStats();
+        }
         return "EOF";
     }
 }
 
+bool FileCommandProcessorAdapter::isStreaming() const {
+    return streaming;
+}
+
+long FileCommandProcessorAdapter::getNumCommandsRead() const {
+    return numCommandsRead;
+}
+
+double FileCommandProcessorAdapter::getCommandsPerSecond() const {
+    if (numCommandsRead == 0) {
+        return 0;
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - firstRead).count();
+    return seconds > 0 ? numCommandsRead / seconds : 0;
+}
+
+/**
+ * prints how many commands were replayed and how fast, once the end of the script is reached
+ */
+void FileCommandProcessorAdapter::reportStats() {
+    double seconds = numCommandsRead == 0 ? 0 : chrono::duration<double>(chrono::steady_clock::now() - firstRead).count();
+    cout << "Replayed " << numCommandsRead << " commands in " << seconds << " s ("
+         << getCommandsPerSecond() << " commands/sec)." << endl;
+    statsReported = true;
+}
+
 /**
 method inherited from ILoggable
  */
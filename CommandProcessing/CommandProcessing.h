@@ -9,6 +9,8 @@
 #include <vector>
 #include <iostream>
 #include <fstream>
+#include <chrono>
+#include <memory>
 #include "../GameEngine/GameEngine.h"
 #include "../Logging/LoggingObserver.h"
 using namespace std;
@@ -49,6 +51,8 @@ public:
     void setNumOfGames(int num);
     int getNumOfTurns();
     void setNumOfTurns(int num);
+    string getResumeFile();
+    void setResumeFile(string resumeFile);
 
     // ILoggable
     virtual string stringToLog();
@@ -63,12 +67,14 @@ private:
     vector<string> playerStrategiesList;
     int numOfGames;
     int numOfTurns;
+    string resumeFile; //checkpoint a tournament is resumed from, empty for a new tournament
 };
 
 class CommandProcessor : public Subject{
 public:
     //Constructor and destructor
     CommandProcessor();
+    CommandProcessor(const CommandProcessor& c);
     virtual ~CommandProcessor();
 
     //Methods requested from the assignment hand out
@@ -78,7 +84,15 @@ public:
 
     Command* getLastCommandInList();
 
-    vector<Command*> getCommandList(); //accessor for list of commands, just in case
+    vector<Command*> getCommandList(); //accessor for list of commands, just in case, the commands stay owned by the processor
+
+    /**
+     * bounds the number of commands kept in the list, the oldest ones are deleted first
+     * the last command returned by getCommand is always kept
+     * @param historyLimit maximum number of commands kept, 0 keeps all of them
+     */
+    virtual void setHistoryLimit(size_t historyLimit);
+    size_t getHistoryLimit() const;
     CommandProcessor& operator =(const CommandProcessor& c);
     friend std::ostream& operator<<(std::ostream& stream, const CommandProcessor& com);
 
@@ -89,7 +103,8 @@ protected:
     virtual string readCommand(); //takes input from the console
     void saveCommand(string command); //saves the command received by input into a command object
 private:
-    vector<Command*> commandList;
+    vector<unique_ptr<Command>> commandList;
+    size_t historyLimit;
 
 };
 
@@ -98,6 +113,7 @@ public:
     //Constructor and destructor
     FileLineReader();
     FileLineReader(string filename);
+    FileLineReader(string filename, size_t chunkSize);
     ~FileLineReader();
 
     //methods used for reading the text files
@@ -106,10 +122,18 @@ public:
 
     //mutator for the file input stream
     void setFStr(fstream* ifstr);
+
+    static const size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
 private:
     string filename;
     string currentLine;
     fstream* _ifstr; //file input stream from where lines are being read
+
+    //the file is read chunkSize bytes at a time, lines are then cut out of the buffer
+    size_t chunkSize;
+    string buffer;
+    size_t bufferPosition;
+    bool fillBuffer();
 };
 
 class FileCommandProcessorAdapter : public CommandProcessor {
@@ -117,11 +141,26 @@ public:
     //constructor and destructor
     FileCommandProcessorAdapter();
     FileCommandProcessorAdapter(string filename);
+
+    /**
+     * streaming replay of a command script: the file is read in large chunks, commands are not echoed,
+     * only the last historyLimit commands are kept, and the replay speed is reported when the script ends
+     */
+    FileCommandProcessorAdapter(string filename, size_t historyLimit);
     ~FileCommandProcessorAdapter();
 
+    static const size_t STREAMING_CHUNK_SIZE = 1024 * 1024;
+    static const size_t DEFAULT_STREAMING_HISTORY = 64;
+
     //adapter pattern: explained in definition
     Command* getCommand(); //public get command method for other classes
 
+    void setHistoryLimit(size_t historyLimit) override; //also bounds the commands read from the console
+
+    bool isStreaming() const;
+    long getNumCommandsRead() const;
+    double getCommandsPerSecond() const; //replay speed, measured from the first command read
+
     FileCommandProcessorAdapter& operator =(const FileCommandProcessorAdapter& c);
     friend std::ostream& operator<<(std::ostream& stream, const FileCommandProcessorAdapter& com);
 
@@ -132,6 +171,13 @@ private:
     bool usingConsole; //for adapter pattern
     FileLineReader* flr;
     CommandProcessor* comPro;
+
+    //streaming replay mode
+    bool streaming;
+    bool statsReported;
+    long numCommandsRead;
+    chrono::steady_clock::time_point firstRead;
+    void reportStats();
 };
 
 
@@ -0,0 +1,66 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "BoardHistory.h"
+#include "TournamentResults.h"
+#include <algorithm>
+
+BoardHistory::BoardHistory() : unchangedTurns(0), stalemateTurns(0) {}
+
+void BoardHistory::clear() {
+    ownershipHashes.clear();
+    boardHashes.clear();
+    boardCounts.clear();
+    unchangedTurns = 0;
+}
+
+void BoardHistory::setStalemateTurns(int turns) {
+    stalemateTurns = max(turns, 0);
+}
+
+int BoardHistory::getStalemateTurns() const {
+    return stalemateTurns;
+}
+
+string BoardHistory::record(uint64_t ownershipHash, uint64_t boardHash) {
+    bool unchanged = !ownershipHashes.empty() && ownershipHashes.back() == ownershipHash;
+    unchangedTurns = unchanged ? unchangedTurns + 1 : 0;
+    ownershipHashes.push_back(ownershipHash);
+    boardHashes.push_back(boardHash);
+    if (++boardCounts[boardHash] >= MAX_REPETITIONS && stalemateTurns > 0) {
+        return CellResult::REPETITION;
+    }
+    if (unchangedTurns >= stalemateTurns && stalemateTurns > 0) {
+        return CellResult::STALEMATE;
+    }
+    return "";
+}
+
+void BoardHistory::restore(const vector<uint64_t> &ownershipHashes, const vector<uint64_t> &boardHashes) {
+    clear();
+    for (size_t i = 0; i < ownershipHashes.size() && i < boardHashes.size(); i++) {
+        record(ownershipHashes[i], boardHashes[i]);
+    }
+}
+
+const vector<uint64_t> &BoardHistory::getOwnershipHashes() const {
+    return ownershipHashes;
+}
+
+const vector<uint64_t> &BoardHistory::getBoardHashes() const {
+    return boardHashes;
+}
+
+string BoardHistory::describe(const string &reason) const {
+    if (reason == CellResult::STALEMATE) {
+        return "no territory changed hands in the last " + to_string(stalemateTurns) + " turns";
+    }
+    if (reason == CellResult::REPETITION) {
+        return "the same board was reached " + to_string(MAX_REPETITIONS) + " times";
+    }
+    if (reason == CellResult::TIME_BUDGET) {
+        return "the game used up its time budget";
+    }
+    return reason;
+}
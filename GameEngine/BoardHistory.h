@@ -0,0 +1,64 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#ifndef COMP345_N11_BOARDHISTORY_H
+#define COMP345_N11_BOARDHISTORY_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+/**
+ * Zobrist hashes of the board at the start of a game and at the end of each of its turns, used to end a game that
+ * stopped progressing as a draw instead of playing it until the last turn.
+ * Ending games early is opt-in: once enabled, a game is a stalemate when no territory changed hands for the given
+ * number of turns in a row, and a repetition when the same owners and armies were seen MAX_REPETITIONS times.
+ * The hashes cover the territories only, not the hands, reinforcement pools or playing order, so a game ended early
+ * may have gone on differently.
+ */
+class BoardHistory {
+public:
+    static const int MAX_REPETITIONS = 3;
+
+    BoardHistory();
+
+    void clear();
+
+    /**
+     * @param turns turns without any territory changing hands after which a game is a stalemate, 0 to never end a
+     * game early, the default
+     */
+    void setStalemateTurns(int turns);
+    int getStalemateTurns() const;
+
+    /**
+     * adds the board at the end of a turn, the first board of a game being the one it starts with
+     * @return why the game should end as a draw, CellResult::STALEMATE or CellResult::REPETITION, empty to go on
+     */
+    string record(uint64_t ownershipHash, uint64_t boardHash);
+
+    /**
+     * rebuilds the history of a game resumed from a checkpoint
+     */
+    void restore(const vector<uint64_t> &ownershipHashes, const vector<uint64_t> &boardHashes);
+
+    const vector<uint64_t> &getOwnershipHashes() const;
+    const vector<uint64_t> &getBoardHashes() const;
+
+    /**
+     * @return sentence explaining a reason returned by record, or CellResult::TIME_BUDGET
+     */
+    string describe(const string &reason) const;
+
+private:
+    vector<uint64_t> ownershipHashes;
+    vector<uint64_t> boardHashes;
+    unordered_map<uint64_t, int> boardCounts;
+    int unchangedTurns;
+    int stalemateTurns; //0 while games are not ended early
+};
+
+#endif //COMP345_N11_BOARDHISTORY_H
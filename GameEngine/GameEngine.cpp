@@ -5,10 +5,20 @@
 #include "../GameEngine/GameEngine.h"
 #include "../CommandProcessing/CommandProcessing.h"
 #include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <math.h>
 #include <string>
 #include "../Cards/Cards.h"
 #include "../PlayerStrategy/PlayerStrategy.h"
+#include "../Stats/Stats.h"
+#include "../Stats/Trace.h"
+#include "../Map/BoardStats.h"
+#include "../Player/DiplomacyMatrix.h"
+#include "../Replay/GameRecorder.h"
+#include "TournamentCheckpoint.h"
+#include "TournamentResults.h"
+#include "MapPrefetcher.h"
 
 
 
@@ -19,6 +29,9 @@ vector<PlayerStrategy*>GameEngine:: strategyType = {new AggressivePlayerStrategy
                                                     new NeutralPlayerStrategy(), new CheaterPlayerStrategy(),
                                                     new BenevolentPlayerStrategy()
 };
+const string GameEngine::STATS_FILE = "../Logging/stats.json";
+const string GameEngine::CHECKPOINT_FILE = "../Logging/tournament.checkpoint";
+const string GameEngine::RESULTS_FILE = "../Logging/tournament.results";
 
 /*
 ===================================
@@ -28,21 +41,30 @@ vector<PlayerStrategy*>GameEngine:: strategyType = {new AggressivePlayerStrategy
 
 // Default constructor
 GameEngine::GameEngine() : MAP_DIRECTORY("../Map/maps/"), MIN_NUM_PLAYERS(2), MAX_NUM_PLAYERS(6) {
-    map_ = nullptr;
+    fixedSeed = false;
+    baseSeed = 0;
+    gameSeed = 0;
+    numGamesStarted = 0;
+    checkpoint = nullptr;
+    sweep = false;
+    shardIndex = 0;
+    shardCount = 1;
+    memoryReport = false;
+    gameBudget = 0;
+    nextStep = GameStep::OVER;
+    maxTurns = 0;
+    turnCount = 0;
     phase = new Phases(Phases::START);
     mode = new Modes(Modes::STARTUP);
-    commandProcessor = new FileCommandProcessorAdapter("../GameEngine/GECommands.txt");
-    for(int i = 0; i < 10; i++) {
-        deck->addCard(new Card("bomb"));
-        deck->addCard(new Card("reinforcement"));
-        deck->addCard(new Card("blockade"));
-        deck->addCard(new Card("airlift"));
-        deck->addCard(new Card("diplomacy"));
+    setCommandProcessor(new FileCommandProcessorAdapter("../GameEngine/GECommands.txt"));
+    diplomacy = new DiplomacyMatrix();
+    for(int i = 0; i < NUM_CARD_TYPES; i++) {
+        deck->addCards(static_cast<CardType>(i), 10);
     }
 }
 
 // Copy constructor of Game Engine
-GameEngine::GameEngine(const GameEngine &anotherGameEngine) : MAP_DIRECTORY(anotherGameEngine.MAP_DIRECTORY), MIN_NUM_PLAYERS(anotherGameEngine.MIN_NUM_PLAYERS), MAX_NUM_PLAYERS(anotherGameEngine.MAX_NUM_PLAYERS) {
+GameEngine::GameEngine(const GameEngine &anotherGameEngine) : Subject(anotherGameEngine), MAP_DIRECTORY(anotherGameEngine.MAP_DIRECTORY), MIN_NUM_PLAYERS(anotherGameEngine.MIN_NUM_PLAYERS), MAX_NUM_PLAYERS(anotherGameEngine.MAX_NUM_PLAYERS) {
     this -> phase = new Phases(*anotherGameEngine.phase);
     this -> mode = new Modes(*anotherGameEngine.mode);
     for (auto player : anotherGameEngine.players_){
@@ -53,10 +75,29 @@ GameEngine::GameEngine(const GameEngine &anotherGameEngine) : MAP_DIRECTORY(anot
         Player* player_temp = new Player(*player);
         this->playingOrder.push_back(player_temp);
     }
-    this->commandProcessor = new CommandProcessor(*anotherGameEngine.commandProcessor);
+    this->commandProcessor.reset(new CommandProcessor(*anotherGameEngine.commandProcessor));
+    this->diplomacy = new DiplomacyMatrix();
     this->deck = new Deck(*anotherGameEngine.deck);
     this->neutralPlayer = new Player(*anotherGameEngine.neutralPlayer);
-    this->map_ = new Map(*anotherGameEngine.map_);
+    this->map_.reset(anotherGameEngine.map_ != nullptr ? new Map(*anotherGameEngine.map_) : nullptr);
+    this->mapFileName = anotherGameEngine.mapFileName;
+    this->fixedSeed = anotherGameEngine.fixedSeed;
+    this->baseSeed = anotherGameEngine.baseSeed;
+    this->gameSeed = anotherGameEngine.gameSeed;
+    this->numGamesStarted = anotherGameEngine.numGamesStarted;
+    this->recordDirectory = anotherGameEngine.recordDirectory;
+    this->recorder.reset();
+    this->checkpoint = nullptr;
+    this->sweep = anotherGameEngine.sweep;
+    this->shardIndex = anotherGameEngine.shardIndex;
+    this->shardCount = anotherGameEngine.shardCount;
+    this->memoryReport = anotherGameEngine.memoryReport;
+    this->gameBudget = anotherGameEngine.gameBudget;
+    this->boardHistory.setStalemateTurns(anotherGameEngine.boardHistory.getStalemateTurns());
+    this->telemetryDirectory = anotherGameEngine.telemetryDirectory;
+    this->nextStep = GameStep::OVER;
+    this->maxTurns = 0;
+    this->turnCount = 0;
 }
 
 // Destructor
@@ -91,9 +132,9 @@ GameEngine::~GameEngine() {
         delete mode;
         mode = nullptr;
     }
-    if(commandProcessor != nullptr) {
-        delete commandProcessor;
-        commandProcessor = nullptr;
+    if(diplomacy != nullptr) {
+        delete diplomacy;
+        diplomacy = nullptr;
     }
     if(deck != nullptr) {
         delete deck;
@@ -103,10 +144,7 @@ GameEngine::~GameEngine() {
         delete neutralPlayer;
         neutralPlayer = nullptr;
     }
-    if(map_ != nullptr) {
-        delete map_;
-        map_ = nullptr;
-    }
+    // the map, the command processor and the recorder are deleted with the engine
 }
 
 // Assignment operator
@@ -119,10 +157,29 @@ GameEngine &GameEngine::operator=(const GameEngine &anotherGameEngine) {
     for (auto player : anotherGameEngine.playingOrder){
         this->playingOrder.push_back(new Player(*player));
     }
-    this->commandProcessor = new CommandProcessor(*anotherGameEngine.commandProcessor);
+    this->commandProcessor.reset(new CommandProcessor(*anotherGameEngine.commandProcessor));
+    this->diplomacy = new DiplomacyMatrix();
     this->deck = new Deck(*anotherGameEngine.deck);
     this->neutralPlayer = new Player(*anotherGameEngine.neutralPlayer);
-    this->map_ = new Map(*anotherGameEngine.map_);
+    this->map_.reset(anotherGameEngine.map_ != nullptr ? new Map(*anotherGameEngine.map_) : nullptr);
+    this->mapFileName = anotherGameEngine.mapFileName;
+    this->fixedSeed = anotherGameEngine.fixedSeed;
+    this->baseSeed = anotherGameEngine.baseSeed;
+    this->gameSeed = anotherGameEngine.gameSeed;
+    this->numGamesStarted = anotherGameEngine.numGamesStarted;
+    this->recordDirectory = anotherGameEngine.recordDirectory;
+    this->recorder.reset();
+    this->checkpoint = nullptr;
+    this->sweep = anotherGameEngine.sweep;
+    this->shardIndex = anotherGameEngine.shardIndex;
+    this->shardCount = anotherGameEngine.shardCount;
+    this->memoryReport = anotherGameEngine.memoryReport;
+    this->gameBudget = anotherGameEngine.gameBudget;
+    this->boardHistory.setStalemateTurns(anotherGameEngine.boardHistory.getStalemateTurns());
+    this->telemetryDirectory = anotherGameEngine.telemetryDirectory;
+    this->nextStep = GameStep::OVER;
+    this->maxTurns = 0;
+    this->turnCount = 0;
     return *this;
 }
 
@@ -137,12 +194,29 @@ ostream &operator<<(ostream &stream, const GameEngine &gameEngine) {
     return stream;
 }
 
-void GameEngine::assignToNeutralPlayer(Territory* territory)
+void GameEngine::assignToNeutralPlayer(Territory* territory, bool quiet)
 {
+    if (territory->getMap() != nullptr) {
+        territory->getMap()->transferTerritories({territory}, neutralPlayer, quiet);
+        return;
+    }
+    // a territory created on its own, as in the drivers
     Player* owner = territory->getOwner();
     owner->removeTerritory(territory);
     territory->setOwner(neutralPlayer);
     neutralPlayer->addTerritory(territory);
+    if (!quiet) {
+        Stats::increment(StatCounter::TERRITORIES_TRANSFERRED);
+    }
+}
+
+int GameEngine::getStrategyIndex(const Player *player) {
+    auto found = find(strategyType.begin(), strategyType.end(), player->getStrategy());
+    return found == strategyType.end() ? -1 : static_cast<int>(found - strategyType.begin());
+}
+
+Player *GameEngine::getNeutralPlayer() {
+    return neutralPlayer;
 }
 
 const vector<Player *> &GameEngine::getPlayers() {
@@ -166,11 +240,7 @@ void GameEngine::removePlayer(Player *player) {
             break;
         }
     }
-    OrdersList* ol = player -> getPlayerOrdersList();
-    int size = ol->size();
-    for (int k =0 ; k<size; k++){
-        ol->popTopOrder();
-    }
+    player->getPlayerOrdersList()->clear();
 }
 
 /**
@@ -222,76 +292,41 @@ void GameEngine::startupPhase() {
         if(!instruction.empty()) {
 
             // perform the command's required action then save the effect and go to the next phase
-            if(instruction == "tournament" && command->getMapList().size() >= 1 && command->getMapList().size() <= 5 && command->getplayerStrategiesList().size() >= 2  && command->getplayerStrategiesList().size() <= 4 && command->getNumOfGames() >= 1 && command->getNumOfGames() <= 5 && command->getNumOfTurns() >= 10 && command->getNumOfTurns() <= 50 && *phase == Phases::START) {
+            if(instruction == "tournament" && !command->getResumeFile().empty() && *phase == Phases::START) {
+                // resuming a tournament from its last checkpoint, which keeps being updated
+                TournamentCheckpoint resumed;
+                if(resumed.load(command->getResumeFile())) {
+                    cout << "Resuming the tournament of " << command->getResumeFile() << "..." << endl;
+                    playTournament(resumed, command->getResumeFile());
+                    command->saveEffect("Tournament resumed from " + command->getResumeFile() + ".");
+                } else {
+                    cout << "Unable to resume a tournament from " << command->getResumeFile() << endl;
+                    command->saveEffect("Invalid checkpoint. Command Ignored.");
+                }
+            } else if(instruction == "tournament" && (isWithinTournamentLimits(command) || (sweep && command->getNumOfGames() >= 1 && command->getNumOfTurns() >= 1)) && *phase == Phases::START) {
                 // playing in tournament
                 cout << "Playing a tournament..." << endl;
-                int numberOfGames = command->getNumOfGames(); // number of games in a tournament
-                int numberOfMaxTurns = command->getNumOfTurns(); // number of max turns in a game
-                vector<string> mapsList = command->getMapList(); // list of maps
-                int numberOfMaps = mapsList.size(); // number of maps
-
-                // add players
-                vector<string> playersList = command->getplayerStrategiesList();
-                for(int i = 0; i < playersList.size(); i++) {
-                    players_.push_back(new Player("Player" + to_string(i+1) + "_" + playersList.at(i),Player::parsePlayerStrategy(playersList.at(i))));
-                }
-
-                // prepare report of the results
-                string tournamentResult;
-                const int MAX_TABLE_CELL_LENGTH = 25;
-                tournamentResult.append(MAX_TABLE_CELL_LENGTH, ' ');
-                for(int i = 0; i < numberOfGames; i++) {
-                    string gameNumberText = "Game " + to_string(i + 1);
-                    tournamentResult += " | " + gameNumberText.append(MAX_TABLE_CELL_LENGTH - gameNumberText.length(), ' ');
-                }
-                string tournamentMapResult[numberOfMaps];
-
-                // for each map, load map, validate map then start games
-                for (int i = 0; i < numberOfMaps; i++) {
-                    cout << "loading map: " << mapsList.at(i) << endl;
-                    startupMapLoading(mapsList.at(i));
-                    string mapNumberText = "Map " + to_string(i + 1);
-                    tournamentMapResult[i] = mapNumberText.append(MAX_TABLE_CELL_LENGTH - mapNumberText.length(), ' ');
-                    string validationResult = startupMapValidation();
-                    if(validationResult != "Map validated. Transition to [mapvalidated]") {
-                        break;
-                    }
-                    // start games
-                    for(int j = 0; j < numberOfGames; j++) {
-                        cout << "*************************\n*\tGame " << j+1 << "\t\t*\n*************************\n" << endl;
-                        startupGameInitialization(); // initialize game
-                        string result = tournamentPlay(numberOfMaxTurns);
-                        cout << "Result: " << result << endl;
-                        tournamentMapResult[i] += " | " + result.append(MAX_TABLE_CELL_LENGTH - result.length(), ' ');
-
-
-                        // clear playing order list
-                        playingOrder.clear();
-
-                        // return all cards in a player's hand to the deck, and remove all territories
-                        for (auto &player : players_) {
-                            if(player != nullptr) {
-                                if(player->getPlayerCards() != nullptr) {
-                                    player->getPlayerCards()->removeAllCards();
-                                }
-                                // clear all player's ordersList
-                                OrdersList* ol = player -> getPlayerOrdersList();
-                                int size = ol->size();
-                                for (int k =0 ; k<size; k++){
-                                    ol->popTopOrder();
-                                }
-                                player->removeAllTerritories();
-                            }
-                        }
-                        resetPlayerStrategy();
-                    }
-                    tournamentResult += "\n" + tournamentMapResult[i];
-                }
-                cout << "Tournament Result:\n" << tournamentResult << endl;
+                TournamentCheckpoint tournament;
+                tournament.maps = command->getMapList();
+                tournament.strategies = command->getplayerStrategiesList();
+                tournament.numGames = command->getNumOfGames();
+                tournament.maxTurns = command->getNumOfTurns();
+                tournament.fixedSeed = fixedSeed;
+                tournament.baseSeed = baseSeed;
+                tournament.numGamesStarted = numGamesStarted;
+                tournament.shardIndex = shardIndex;
+                tournament.shardCount = shardCount;
+                tournament.results.resize(tournament.maps.size());
+                playTournament(tournament, shardFileName(CHECKPOINT_FILE, shardIndex, shardCount));
                 command->saveEffect("Tournament played.");
-                contentToLog = "Game Engine - tournament result:\n" + tournamentResult;
-                notify();
 
+            } else if(instruction == "tournament" && !sweep && *phase == Phases::START) {
+                cout << "A tournament is limited to 1 to 5 maps, 2 to 4 player strategies, 1 to 5 games and 10 to 50 turns, "
+                        "run the game with --sweep to lift these limits." << endl;
+                command->saveEffect("Tournament out of limits. Command Ignored.");
+            } else if(instruction == "stats") {
+                cout << Stats::report();
+                command->saveEffect("Statistics reported.");
             } else if(instruction == "loadmap" && (*phase == Phases::START || *phase == Phases::MAPLOADED)) {
 
                 // loading map
@@ -345,6 +380,7 @@ void GameEngine::startupPhase() {
                 assignTerritories();
                 cout << "Territories assigned" << endl;
                 assignPlayingOrder();
+                resetDiplomacy();
                 cout << "Playing order determined" << endl;
                 cout << "Order of play of the players:" <<endl;
                 cout << getPlayingOrderPlayersNames() << endl;
@@ -352,6 +388,7 @@ void GameEngine::startupPhase() {
                 cout << "Initial reinforcement accomplished" << endl;
                 initialCardDrawing();
                 cout << "Initial cards drawn" << endl;
+                startRecording();
                 command->saveEffect("Game initiated. Territories distributed. Playing order determined. Initial reinforcement accomplished. Initial cards drawn. Transition to [assignreinforcement]");
                 transition(Phases::ASSIGNREINFORCEMENT);
                 cout << "The game is currently in state: " << phaseToString(*phase) << endl;
@@ -372,16 +409,18 @@ void GameEngine::startupPhase() {
     }
 }
 
-string GameEngine::startupMapLoading(string map) {
-    // delete map
+string GameEngine::startupMapLoading(string map, unique_ptr<Map> preloaded) {
+    // the territories of the previous map are given back before it is deleted by loadMap
     if(map_ != nullptr) {
-//        delete map_;
-        map_ = nullptr;
+        for (auto &player : players_) {
+            player->removeAllTerritories();
+        }
+        neutralPlayer->removeAllTerritories();
     }
 
     // loading map
     cout << "Loading map \"" << map << "\"... " << endl;
-    loadMap(map);
+    loadMap(map, move(preloaded));
     cout << "The loaded map is described as follows:" << endl << *map_ << endl;
     transition(Phases::MAPLOADED);
     cout << "The game is currently in state: " << phaseToString(*phase) << endl;
@@ -391,7 +430,11 @@ string GameEngine::startupMapLoading(string map) {
 string GameEngine::startupMapValidation() {
     // validating map and printing the result
     cout << "Validating the map... " << endl;
-    int validation = map_->validate();
+    return reportMapValidation(map_->validate());
+}
+
+// prints the result of the validation of the loaded map, which may have been validated ahead by a MapPrefetcher
+string GameEngine::reportMapValidation(int validation) {
     switch (validation) {
         case 0:
             cout << "The map is valid." << endl;
@@ -419,6 +462,7 @@ string GameEngine::startupGameInitialization() {
     assignTerritories();
     cout << "Territories assigned" << endl;
     assignPlayingOrder();
+    resetDiplomacy();
     cout << "Playing order determined" << endl;
     cout << "Order of play of the players:" <<endl;
     cout << getPlayingOrderPlayersNames() << endl;
@@ -426,6 +470,7 @@ string GameEngine::startupGameInitialization() {
     cout << "Initial reinforcement accomplished" << endl;
     initialCardDrawing();
     cout << "Initial cards drawn" << endl;
+    startRecording();
     transition(Phases::ASSIGNREINFORCEMENT);
     cout << "The game is currently in state: " << phaseToString(*phase) << endl;
     *mode = Modes::PLAY;
@@ -434,47 +479,432 @@ string GameEngine::startupGameInitialization() {
 }
 
 
-string GameEngine::tournamentPlay(int numberOfMaxTurns) {
-    int turnCount = 0;
-    while (playingOrder.size() > 1 && turnCount < numberOfMaxTurns) {
-        printPlayerStrategy();
-
-        turnCount++;
-        // add armies to each player Reinforcement Pool
-        cout << "***********************************"<<endl;
-        cout << "**\t REINFORCEMENT PHASE\t**"<<endl;
-        cout << "***********************************"<<endl;
+/**
+ * Plays the games of a tournament that were not played yet, saving the progress to a checkpoint after every game and
+ * every few turns, then prints the results. A shard of a sweep only plays its own games and leaves the others empty.
+ */
+void GameEngine::playTournament(TournamentCheckpoint &tournament, const string &checkpointFile) {
+    int numberOfGames = tournament.numGames; // number of games in a tournament
+    int numberOfMaxTurns = tournament.maxTurns; // number of max turns in a game
+    vector<string> mapsList = tournament.maps; // list of maps
+    int numberOfMaps = mapsList.size(); // number of maps
+    fixedSeed = tournament.fixedSeed;
+    baseSeed = tournament.baseSeed;
+    numGamesStarted = tournament.numGamesStarted;
+    checkpoint = &tournament;
+    this->checkpointFile = checkpointFile;
+
+    // add players
+    vector<string> playersList = tournament.strategies;
+    for(int i = 0; i < playersList.size(); i++) {
+        players_.push_back(new Player("Player" + to_string(i+1) + "_" + playersList.at(i),Player::parsePlayerStrategy(playersList.at(i))));
+    }
+    if(tournament.shardCount > 1) {
+        cout << "Playing the shard " << tournament.shardIndex + 1 << "/" << tournament.shardCount << " of the sweep" << endl;
+    }
+    if(!tournament.inGame) {
+        saveCheckpoint(0); // keeps the game in progress of a resumed tournament until it is restored
+    }
 
-        transition(Phases::ASSIGNREINFORCEMENT);
-        reinforcementPhase();
+    // the maps with games left are loaded and validated on another thread while the games of the previous map play
+    vector<bool> hasGamesLeft(numberOfMaps, false);
+    vector<string> mapFiles;
+    for (int i = 0; i < numberOfMaps; i++) {
+        mapFiles.push_back(MAP_DIRECTORY + mapsList.at(i));
+        for(int j = tournament.results[i].size(); j < numberOfGames; j++) {
+            hasGamesLeft[i] = hasGamesLeft[i] || TournamentResults::isInShard(i * numberOfGames + j, tournament.shardIndex, tournament.shardCount);
+        }
+    }
+    MapPrefetcher prefetcher(mapFiles, hasGamesLeft);
+
+    // for each map, take the loaded map, report its validation then start the games not played yet
+    int numberOfMapsPlayed = 0;
+    for (int i = 0; i < numberOfMaps; i++) {
+        vector<CellResult> &mapResults = tournament.results[i];
+        Stats::resetPeakHeap();
+        long mapPeakHeap = 0;
+        int numberOfGamesPlayed = 0;
+        if(hasGamesLeft[i]) {
+            cout << "loading map: " << mapsList.at(i) << endl;
+            PrefetchedMap prefetched = prefetcher.take(i);
+            startupMapLoading(mapsList.at(i), move(prefetched.map));
+            cout << "Validating the map... " << endl;
+            reportMapValidation(prefetched.validation);
+            if(prefetched.validation != 0) {
+                // the games of an invalid map are left unplayed, the other maps are still played
+                cout << "Skipping map " << i+1 << " (" << mapsList.at(i) << ")" << endl;
+                mapResults.resize(numberOfGames, CellResult());
+                saveCheckpoint(0);
+                numberOfMapsPlayed = i + 1;
+                continue;
+            }
+        }
+        // start games
+        for(int j = mapResults.size(); j < numberOfGames; j++) {
+            int cell = i * numberOfGames + j;
+            if(!TournamentResults::isInShard(cell, tournament.shardIndex, tournament.shardCount)) {
+                mapResults.push_back(CellResult());
+                continue;
+            }
+            cout << "*************************\n*\tGame " << j+1 << "\t\t*\n*************************\n" << endl;
+            mapPeakHeap = max(mapPeakHeap, Stats::getPeakHeapBytes());
+            Stats::resetPeakHeap();
+            long gameStartHeap = Stats::getHeapBytes();
+            int turnCount = 0;
+            if(tournament.inGame && tournament.mapIndex == i && tournament.gameIndex == j && restoreGame(tournament)) {
+                turnCount = tournament.turn;
+            } else {
+                // the seed of a game only depends on its cell, so every shard of a sweep gives a game the same seed
+                numGamesStarted = cell;
+                startupGameInitialization(); // initialize game
+            }
+            tournament.mapIndex = i;
+            tournament.gameIndex = j;
+            string reason;
+            string result = tournamentPlay(numberOfMaxTurns, turnCount, reason);
+            cout << "Result: " << result << endl;
+            mapResults.push_back({result, gameSeed, turnCount, reason});
+
+
+            // clear playing order list
+            playingOrder.clear();
+
+            // return all cards in a player's hand to the deck, and remove all territories
+            for (auto &player : players_) {
+                if(player != nullptr) {
+                    if(player->getPlayerCards() != nullptr) {
+                        player->getPlayerCards()->removeAllCards();
+                    }
+                    // clear all player's ordersList
+                    player->getPlayerOrdersList()->clear();
+                    player->removeAllTerritories();
+                }
+            }
+            // the next game starts from an empty board, so its outcome only depends on its seed and shards agree on it
+            neutralPlayer->removeAllTerritories();
+            for (int k = 0; k < map_->getNumTerritories(); k++) {
+                map_->getTerritories()[k]->setNumberOfArmies(0);
+                map_->getTerritories()[k]->setPendingIncomingArmies(0);
+                map_->getTerritories()[k]->setPendingOutgoingArmies(0);
+            }
+            resetPlayerStrategy();
+            saveCheckpoint(0);
+            numberOfGamesPlayed++;
+            if(memoryReport) {
+                cout << "Memory of game " << j+1 << " on map " << i+1 << ": " << Stats::formatBytes(gameStartHeap)
+                     << " at the start, peak " << Stats::formatBytes(Stats::getPeakHeapBytes()) << ", "
+                     << Stats::formatBytes(Stats::getHeapBytes()) << " at the end" << endl;
+            }
+        }
+        if(memoryReport && hasGamesLeft[i]) {
+            cout << "Memory of map " << i+1 << " (" << mapsList.at(i) << "): peak "
+                 << Stats::formatBytes(max(mapPeakHeap, Stats::getPeakHeapBytes())) << " over " << numberOfGamesPlayed
+                 << " game(s), " << Stats::formatBytes(Stats::getHeapBytes()) << " after its games" << endl;
+        }
+        numberOfMapsPlayed = i + 1;
+    }
+    checkpoint = nullptr;
+    if(tournament.isComplete() && *phase != Phases::WIN) {
+        transition(Phases::WIN); // resuming a tournament that was already over
+    }
+    // a finished tournament has nothing left to resume
+    if(tournament.isComplete()) {
+        remove(checkpointFile.c_str());
+    }
+    string tournamentResult = TournamentResults::formatTable(tournament.results, numberOfGames, numberOfMapsPlayed);
+    cout << "Tournament Result:\n" << tournamentResult << endl;
+
+    // the results of the games, merged with the ones of the other shards by GameEngineDriver --merge
+    TournamentResults results;
+    results.maps = tournament.maps;
+    results.strategies = tournament.strategies;
+    results.numGames = numberOfGames;
+    results.maxTurns = numberOfMaxTurns;
+    results.shardIndex = tournament.shardIndex;
+    results.shardCount = tournament.shardCount;
+    results.cells = tournament.results;
+    string resultsFile = shardFileName(RESULTS_FILE, tournament.shardIndex, tournament.shardCount);
+    if(!results.save(resultsFile)) {
+        cout << "Unable to write the results to " << resultsFile << endl;
+    }
+    string statsFile = shardFileName(STATS_FILE, tournament.shardIndex, tournament.shardCount);
+    if(!Stats::dumpJson(statsFile)) {
+        cout << "Unable to write the statistics to " << statsFile << endl;
+    }
+    if(isObserved()) {
+        contentToLog = "Game Engine - tournament result:\n" + tournamentResult;
+        notify();
+    }
+}
 
-        // let each player decide his/her order list
-        cout << "***********************************"<<endl;
-        cout << "**\t ISSUE ORDER PHASE\t**"<<endl;
-        cout << "***********************************"<<endl;
+/**
+ * Name of a file written by one shard of a sweep: "tournament.results" becomes "tournament.shard-2-of-8.results",
+ * so shards run side by side do not overwrite each other's files
+ */
+string GameEngine::shardFileName(const string &fileName, int shardIndex, int shardCount) {
+    if(shardCount <= 1) {
+        return fileName;
+    }
+    string shard = ".shard-" + to_string(shardIndex + 1) + "-of-" + to_string(shardCount);
+    size_t extension = fileName.find_last_of('.');
+    if(extension == string::npos || extension < fileName.find_last_of('/') + 1) {
+        return fileName + shard;
+    }
+    return fileName.substr(0, extension) + shard + fileName.substr(extension);
+}
 
-        transition(Phases::ISSUEORDERS);
-        issueOrdersPhase();
-        cout << endl;
+/**
+ * Saves the progress of the tournament being played, with the state of the game in progress at the end of a turn
+ * @param turn last turn played, 0 between two games
+ */
+void GameEngine::saveCheckpoint(int turn) {
+    if(checkpoint == nullptr) {
+        return;
+    }
+    checkpoint->numGamesStarted = numGamesStarted;
+    checkpoint->inGame = turn > 0;
+    if(checkpoint->inGame) {
+        vector<Player*> allPlayers = {neutralPlayer};
+        allPlayers.insert(allPlayers.end(), players_.begin(), players_.end());
+        auto indexOf = [&allPlayers](const Player *player) {
+            return static_cast<uint8_t>(find(allPlayers.begin(), allPlayers.end(), player) - allPlayers.begin());
+        };
+
+        checkpoint->turn = turn;
+        checkpoint->gameSeed = gameSeed;
+        checkpoint->mapFingerprint = GameRecordFormat::fingerprint(map_.get());
+        checkpoint->armies.clear();
+        for(int i = 0; i < map_->getNumTerritories(); i++) {
+            checkpoint->armies.push_back(map_->getTerritories()[i]->getNumberOfArmies());
+        }
+        // strategies pick among equal territories by their position in the list of the player, so it is kept as is
+        Territory **mapTerritories = map_->getTerritories();
+        checkpoint->players.clear();
+        checkpoint->territories.clear();
+        for(auto &player : allPlayers) {
+            vector<int32_t> playerTerritories;
+            for(auto &territory : player->getTerritories()) {
+                auto found = find(mapTerritories, mapTerritories + map_->getNumTerritories(), territory);
+                if(found != mapTerritories + map_->getNumTerritories()) {
+                    playerTerritories.push_back(static_cast<int32_t>(found - mapTerritories));
+                }
+            }
+            checkpoint->territories.push_back(playerTerritories);
+
+            CheckpointPlayer state = {};
+            int strategyIndex = getStrategyIndex(player);
+            state.strategy = strategyIndex < 0 ? TournamentCheckpoint::NO_STRATEGY : static_cast<uint8_t>(strategyIndex);
+            state.playing = find(playingOrder.begin(), playingOrder.end(), player) != playingOrder.end();
+            state.reinforcementPool = player->getReinforcementPool();
+            for(int type = 0; type < NUM_CARD_TYPES; type++) {
+                state.cards[type] = player->getPlayerCards()->getCount(static_cast<CardType>(type));
+            }
+            checkpoint->players.push_back(state);
+        }
+        checkpoint->playingOrder.clear();
+        for(auto &player : playingOrder) {
+            checkpoint->playingOrder.push_back(indexOf(player));
+        }
+        for(int type = 0; type < NUM_CARD_TYPES; type++) {
+            checkpoint->deckCards[type] = deck->getCount(static_cast<CardType>(type));
+        }
+        checkpoint->ownershipHashes = boardHistory.getOwnershipHashes();
+        checkpoint->boardHashes = boardHistory.getBoardHashes();
+    }
+    if(!checkpoint->save(checkpointFile)) {
+        cout << "Unable to save the progress of the tournament to " << checkpointFile << endl;
+    }
+}
 
-        // execute each player orders from his/her order list
+/**
+ * Sets the board, the players and the deck as they were when a game in progress was checkpointed
+ * @return false if the checkpoint was taken on another version of the map, the game is then restarted
+ */
+bool GameEngine::restoreGame(const TournamentCheckpoint &tournament) {
+    if(tournament.mapFingerprint != GameRecordFormat::fingerprint(map_.get()) ||
+       tournament.armies.size() != static_cast<size_t>(map_->getNumTerritories()) || tournament.players.size() != players_.size() + 1) {
+        cout << "The game in progress does not match the map anymore, it is restarted" << endl;
+        return false;
+    }
+    vector<Player*> allPlayers = {neutralPlayer};
+    allPlayers.insert(allPlayers.end(), players_.begin(), players_.end());
+
+    gameSeed = tournament.gameSeed;
+    numGamesStarted = tournament.numGamesStarted;
+    for(int i = 0; i < map_->getNumTerritories(); i++) {
+        Territory *territory = map_->getTerritories()[i];
+        territory->setNumberOfArmies(tournament.armies[i]);
+        territory->setPendingIncomingArmies(0);
+        territory->setPendingOutgoingArmies(0);
+    }
+    for(size_t i = 0; i < allPlayers.size(); i++) {
+        for(auto &index : tournament.territories[i]) {
+            allPlayers[i]->addTerritory(map_->getTerritories()[index]);
+        }
+        const CheckpointPlayer &state = tournament.players[i];
+        if(state.strategy < strategyType.size()) {
+            allPlayers[i]->setStrategy(state.strategy);
+        }
+        allPlayers[i]->setReinforcementPool(state.reinforcementPool);
+        allPlayers[i]->getPlayerCards()->removeAllCards();
+        for(int type = 0; type < NUM_CARD_TYPES; type++) {
+            for(int k = 0; k < state.cards[type]; k++) {
+                allPlayers[i]->getPlayerCards()->takeFromDeck(deck, static_cast<CardType>(type));
+            }
+        }
+    }
+    for(int type = 0; type < NUM_CARD_TYPES; type++) {
+        CardType cardType = static_cast<CardType>(type);
+        while(deck->getCount(cardType) < tournament.deckCards[type]) {
+            deck->addCard(cardType);
+        }
+        while(deck->getCount(cardType) > tournament.deckCards[type] && deck->take(cardType)) {}
+    }
+    playingOrder.clear();
+    for(auto &index : tournament.playingOrder) {
+        playingOrder.push_back(allPlayers[index]);
+    }
+    resetDiplomacy();
+    boardHistory.restore(tournament.ownershipHashes, tournament.boardHashes);
+    cout << "Game resumed after turn " << tournament.turn << ", random seed of the game: " << gameSeed << endl;
+    transition(Phases::ASSIGNREINFORCEMENT);
+    *mode = Modes::PLAY;
+    return true;
+}
 
-        cout << "***********************************"<<endl;
-        cout << "**\t EXECUTE ORDER PHASE\t**"<<endl;
-        cout << "***********************************"<<endl;
+/**
+ * Plays a game of a tournament until a player wins, the last turn is played, the board shows the game is stuck if
+ * enabled, or its time budget is used up. The game is played one step at a time, the budget being checked between
+ * two steps; a game over its budget is cancelled and ends as a draw once its current turn is over.
+ * @param turnCount turns already played, then turns played in all
+ * @param reason set to how the game ended, one of the reasons of CellResult
+ * @return the name of the winner, or "Draw"
+ */
+string GameEngine::tournamentPlay(int numberOfMaxTurns, int &turnCount, string &reason) {
+    startGame(numberOfMaxTurns, turnCount);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    bool cancelled = false;
+    while (step()) {
+        if (!cancelled && gameBudget > 0 && chrono::steady_clock::now() - start > chrono::milliseconds(gameBudget)) {
+            cancelled = true;
+            cancelGame(CellResult::TIME_BUDGET);
+        }
+    }
+    return getGameResult(turnCount, reason);
+}
 
-        transition(Phases::EXECUTEORDERS);
-        executeOrdersPhase();
-        cout << endl;
+void GameEngine::startGame(int numberOfMaxTurns, int turnCount) {
+    maxTurns = numberOfMaxTurns;
+    this->turnCount = turnCount;
+    drawReason.clear();
+    cancelReason.clear();
+    gameResult.clear();
+    gameEndReason.clear();
+    if (turnCount == 0) {
+        boardHistory.clear();
+        boardHistory.record(map_->getOwnershipHash(), map_->getBoardHash());
     }
-    transition(Phases::WIN);
-    if(playingOrder.size() == 1) {
-        cout << "The winner of the game is : "<< playingOrder.at(0)->getName()<<" ownes ";
-        cout <<playingOrder.at(0)->getTerritories().size()<<" territories"<<endl;
-        return playingOrder.at(0)->getName();
+    if (!telemetryDirectory.empty()) {
+        telemetry.begin(players_, numberOfMaxTurns - turnCount);
     }
-    cout << "The game ended in draw" << endl;
-    return "Draw";
+    nextStep = GameStep::BEGINTURN;
+}
+
+// a turn is played in five steps, the game ending at the start of a turn once it has to
+bool GameEngine::step() {
+    switch (nextStep) {
+        case GameStep::BEGINTURN:
+            if (!cancelReason.empty() && drawReason.empty()) {
+                drawReason = cancelReason;
+            }
+            if (playingOrder.size() <= 1 || turnCount >= maxTurns || !drawReason.empty()) {
+                nextStep = GameStep::ENDGAME;
+                return true;
+            }
+            printPlayerStrategy();
+
+            turnCount++;
+            turnSpan.reset(new TraceSpan("Turn", "turn", Trace::isEnabled() ? "\"turn\": " + to_string(turnCount) + ", \"game\": " + to_string(numGamesStarted) : ""));
+            // every turn is seeded from the seed of the game, so a game resumed from a checkpoint plays the same turns
+            srand(gameSeed + static_cast<unsigned>(turnCount) * 2654435761u);
+            nextStep = GameStep::REINFORCEMENT;
+            return true;
+        case GameStep::REINFORCEMENT:
+            // add armies to each player Reinforcement Pool
+            cout << "***********************************"<<endl;
+            cout << "**\t REINFORCEMENT PHASE\t**"<<endl;
+            cout << "***********************************"<<endl;
+
+            transition(Phases::ASSIGNREINFORCEMENT);
+            reinforcementPhase();
+            nextStep = GameStep::ISSUEORDERS;
+            return true;
+        case GameStep::ISSUEORDERS:
+            // let each player decide his/her order list
+            cout << "***********************************"<<endl;
+            cout << "**\t ISSUE ORDER PHASE\t**"<<endl;
+            cout << "***********************************"<<endl;
+
+            transition(Phases::ISSUEORDERS);
+            issueOrdersPhase();
+            cout << endl;
+            nextStep = GameStep::EXECUTEORDERS;
+            return true;
+        case GameStep::EXECUTEORDERS:
+            // execute each player orders from his/her order list
+
+            cout << "***********************************"<<endl;
+            cout << "**\t EXECUTE ORDER PHASE\t**"<<endl;
+            cout << "***********************************"<<endl;
+
+            transition(Phases::EXECUTEORDERS);
+            executeOrdersPhase();
+            cout << endl;
+            nextStep = GameStep::ENDTURN;
+            return true;
+        case GameStep::ENDTURN:
+            phaseSpan.reset(); // the phases of a turn end with it on the timeline
+            drawReason = boardHistory.record(map_->getOwnershipHash(), map_->getBoardHash());
+            telemetry.endTurn(turnCount, map_->getBoardStats());
+
+            if (turnCount % CHECKPOINT_INTERVAL == 0 && playingOrder.size() > 1 && turnCount < maxTurns && drawReason.empty() && cancelReason.empty()) {
+                saveCheckpoint(turnCount);
+            }
+            turnSpan.reset();
+            nextStep = GameStep::BEGINTURN;
+            return true;
+        case GameStep::ENDGAME:
+            transition(Phases::WIN);
+            stopRecording();
+            saveTelemetry();
+            nextStep = GameStep::OVER;
+            if(playingOrder.size() == 1) {
+                cout << "The winner of the game is : "<< playingOrder.at(0)->getName()<<" ownes ";
+                cout <<map_->getBoardStats()->of(playingOrder.at(0)).territories<<" territories"<<endl;
+                gameResult = playingOrder.at(0)->getName();
+                gameEndReason = CellResult::CONQUEST;
+                return false;
+            }
+            if (!drawReason.empty()) {
+                cout << "The game is stopped after turn " << turnCount << ": " << boardHistory.describe(drawReason) << endl;
+            }
+            cout << "The game ended in draw" << endl;
+            gameResult = "Draw";
+            gameEndReason = drawReason.empty() ? CellResult::MAX_TURNS : drawReason;
+            return false;
+        default:
+            return false;
+    }
+}
+
+void GameEngine::cancelGame(const string &reason) {
+    cancelReason = reason;
+}
+
+string GameEngine::getGameResult(int &turnCount, string &reason) const {
+    turnCount = this->turnCount;
+    reason = gameEndReason;
+    return gameResult;
 }
 
 
@@ -482,10 +912,12 @@ string GameEngine::tournamentPlay(int numberOfMaxTurns) {
 /**
  * Loads the map form a file
  * @param filename
+ * @param preloaded the map of the file when it was already loaded, e.g. by a MapPrefetcher
  */
-void GameEngine::loadMap(string filename){
+void GameEngine::loadMap(string filename, unique_ptr<Map> preloaded){
     cout << "Loading map ..." << endl;
-    map_ = MapLoader::loadMapFile(MAP_DIRECTORY + filename);
+    mapFileName = MAP_DIRECTORY + filename;
+    map_ = preloaded != nullptr ? move(preloaded) : unique_ptr<Map>(MapLoader::loadMapFile(mapFileName));
     cout << "Map was loaded successfully!" << endl;
 };
 
@@ -546,7 +978,11 @@ void GameEngine::assignTerritories() {
  */
 void GameEngine::assignPlayingOrder() {
     // the playing order is randomly determined from the set of all players
-    srand(static_cast<unsigned>(time(nullptr)));
+    // the seed is kept so the game can be reproduced, it drives every random choice made until the next game
+    gameSeed = fixedSeed ? baseSeed + static_cast<unsigned>(numGamesStarted) : static_cast<unsigned>(time(nullptr));
+    numGamesStarted++;
+    srand(gameSeed);
+    cout << "Random seed of the game: " << gameSeed << endl;
     int numAssignedPlayers = 0;
     int numPlayers = static_cast<int>(players_.size());
     int alreadyAssignedPlayers[numPlayers];
@@ -566,6 +1002,17 @@ void GameEngine::assignPlayingOrder() {
     }
 }
 
+/**
+ * A new game starts without any truce between its players
+ */
+void GameEngine::resetDiplomacy() {
+    diplomacy->reset();
+    diplomacy->registerPlayer(neutralPlayer);
+    for (auto &player : playingOrder) {
+        diplomacy->registerPlayer(player);
+    }
+}
+
 /**
  * Initial reinforcement
  */
@@ -681,31 +1128,33 @@ void GameEngine::mainGameLoop() {
         }
     }
     transition(Phases::WIN);
+    stopRecording();
     cout << "The winner of the game is : "<< playingOrder.at(0)->getName()<<" ownes ";
     cout <<playingOrder.at(0)->getTerritories().size()<<" territories"<<endl;
     playingOrder.at(0)->getPlayerCards()->removeAllCards();
 
-    OrdersList* ol = playingOrder.at(0) -> getPlayerOrdersList();
-    int size = ol->size();
-    for (int k =0 ; k<size; k++){
-        ol->popTopOrder();
-    }
+    playingOrder.at(0)->getPlayerOrdersList()->clear();
 }
 
 /**
  * assign reinforcement for each player
  */
 void GameEngine::reinforcementPhase() {
+    ScopedTimer timer(Stats::phase(StatPhase::REINFORCEMENT));
+    // territory counts and continent bonuses of all the players come from one sweep of the board
+    BoardStats* boardStats = map_->getBoardStats();
     for (auto &player:playingOrder){
-        int armies = floor(double(player->getTerritories().size())/3);
-        cout << "Since "<< player->getName() << " owns "<< player->getTerritories().size()<< " territories, "<< armies;
+        const PlayerBoardStats &stats = boardStats->of(player);
+        int armies = stats.territories / 3;
+        cout << "Since "<< player->getName() << " owns "<< stats.territories << " territories, "<< armies;
         cout<<" armies will be added to his reinforcement pool"<< endl;
-        for(int i = 0; i<map_->getNumContinent();i++){
+        // the continents are only listed for the players owning some
+        for(int i = 0; stats.continents > 0 && i<map_->getNumContinent();i++){
             if (map_->getContinent()[i]->getOwner()==player){
                 cout <<"Adding "<<map_->getContinent()[i]->getName()<<" bonus armies to "<<player->getName()<<" to his reinforcement pool"<< endl;
-                armies = armies + map_->getContinent()[i]->getBonus();
             }
         }
+        armies = armies + stats.continentBonus;
         if (armies<3){
             cout << "However,the number of armies calculated to "<<player->getName()<<" is less than 3; therefore, the player "
                                                                               "will be given 3 armies instead"<< endl;
@@ -721,9 +1170,27 @@ void GameEngine::reinforcementPhase() {
  * asking the player to start their issuing their orders
  */
 void GameEngine::issueOrdersPhase() {
+    ScopedTimer timer(Stats::phase(StatPhase::ISSUE_ORDERS));
+    if (recorder != nullptr) {
+        recorder->beginTurn();
+    }
     for (auto &player : playingOrder){
+        // a player conquered by a player issuing orders before it has nothing left to order
+        if (player->getTerritories().empty()) {
+            continue;
+        }
         cout << "***\t\tIt is "<<player->getName() << " turn to issue Orders\t\t***"<<endl;
-        player->issueOrder();
+        // time spent by each kind of strategy, the strategies being shared by all the players using them
+        int strategyIndex = getStrategyIndex(player);
+        TraceSpan issueSpan("issueOrder", "player", Trace::isEnabled() ? "\"player\": \"" + Trace::escape(player->getName()) + "\"" : "");
+        long ordersIssued = Stats::get(StatCounter::ORDERS_ISSUED);
+        if (strategyIndex >= 0 && strategyIndex < NUM_STAT_STRATEGIES) {
+            ScopedTimer strategyTimer(Stats::strategy(strategyIndex));
+            player->issueOrder();
+        } else {
+            player->issueOrder();
+        }
+        telemetry.ordersIssued(player, Stats::get(StatCounter::ORDERS_ISSUED) - ordersIssued);
         cout<<endl;
     }
 }
@@ -732,6 +1199,7 @@ void GameEngine::issueOrdersPhase() {
  * execute player orders from their order list
  */
 void GameEngine::executeOrdersPhase() {
+    ScopedTimer timer(Stats::phase(StatPhase::EXECUTE_ORDERS));
     int longestOrderList = 0 ;
     int sum = 0 ;
     // find the longest order list of a player
@@ -742,8 +1210,10 @@ void GameEngine::executeOrdersPhase() {
         }
     }
 
+    // every deploy order is executed before any other order, one per player in turn until none is left
     bool reach_end = false;
     while(!reach_end) {
+        reach_end = true;
         for (auto &player: playingOrder) {
             int i = 0;
             for (; i < longestOrderList; i++) {
@@ -752,17 +1222,19 @@ void GameEngine::executeOrdersPhase() {
                     cout << "The execution for the order " << *player->getPlayerOrdersList()->getOrders().at(i)
                          << " of " << player->getName() << endl;
                     Order *order = player->getPlayerOrdersList()->getOrders().at(i);
-                    order->execute();
+                    if (recorder != nullptr) {
+                        recorder->recordOrder(order);
+                    }
+                    telemetry.orderExecuted(player, order->execute());
                     player->getPlayerOrdersList()->removeOrder(order);
                     sum = sum-1;
+                    reach_end = false;
                     break;
                 }
             }
-            if (player->getPlayerOrdersList()->size() == 0 || (i>=player->getPlayerOrdersList()->size() && player == playingOrder.at(playingOrder.size()-1))){
-                reach_end = true;
-            }
         }
     }
+
     bool onePlayer  = false;
     while (sum>0 && !onePlayer){
         for (auto &player: playingOrder) {
@@ -773,7 +1245,10 @@ void GameEngine::executeOrdersPhase() {
                          << " of ";
                     cout << player->getName() << endl;
                     Order *order = player->getPlayerOrdersList()->getOrders().at(i);
-                    order->execute();
+                    if (recorder != nullptr) {
+                        recorder->recordOrder(order);
+                    }
+                    telemetry.orderExecuted(player, order->execute());
                     player->getPlayerOrdersList()->removeOrder(order);
                     sum = sum - 1;
                     break;
@@ -793,6 +1268,33 @@ void GameEngine::executeOrdersPhase() {
             }
         }
     }
+
+    // the territories the strategies take directly, as the cheater does, once every order of the turn is executed:
+    // the armies deployed this turn stay with the players who deployed them, and the truces negotiated this turn
+    // protect from these conquests as they do from any attack
+    if (recorder != nullptr) {
+        recorder->beginTransfers();
+    }
+    for (auto &player : playingOrder) {
+        if (!onePlayer && !player->getTerritories().empty()) {
+            player->conquer();
+        }
+    }
+
+    // the players left without territories, including those conquered directly
+    for (size_t i = 0; i < playingOrder.size() && playingOrder.size() > 1;) {
+        if (playingOrder.at(i)->getTerritories().empty()) {
+            removePlayer(playingOrder.at(i));
+        } else {
+            i++;
+        }
+    }
+
+    // truces only hold for the rest of the turn
+    diplomacy->nextTurn();
+    if (recorder != nullptr) {
+        recorder->endTurn();
+    }
 }
 
 // Iloggable
@@ -834,9 +1336,15 @@ string GameEngine::phaseToString(Phases phase) {
 
 void GameEngine::transition(Phases phaseToTransition) {
     *phase = phaseToTransition;
-    string phaseString = phaseToString(phaseToTransition);
-    contentToLog = "Game Engine - changing to phase: " + phaseString;
-    notify();
+    // a phase lasts until the next transition
+    phaseSpan.reset();
+    if(Trace::isEnabled()) {
+        phaseSpan.reset(new TraceSpan(phaseToString(phaseToTransition), "phase"));
+    }
+    if(isObserved()) {
+        contentToLog = "Game Engine - changing to phase: " + phaseToString(phaseToTransition);
+        notify();
+    }
 }
 
 vector<Player *> GameEngine::getPlayingOrder() {
@@ -856,11 +1364,7 @@ void GameEngine::gameReset() {
             if(player->getPlayerCards() != nullptr) {
                 player->getPlayerCards()->removeAllCards();
             }
-            OrdersList* ol = player -> getPlayerOrdersList();
-            int size = ol->size();
-            for (int k =0 ; k<size; k++){
-                ol->popTopOrder();
-            }
+            player->getPlayerOrdersList()->clear();
             player->removeAllTerritories();
             delete player;
             player = nullptr;
@@ -869,11 +1373,7 @@ void GameEngine::gameReset() {
     players_.clear();
 
     cout << "\tDeleting the map..." << endl;
-    // delete map
-    if(map_ != nullptr) {
-        delete map_;
-        map_ = nullptr;
-    }
+    map_.reset();
 
     cout << "\tResetting game's mode and phase..." << endl;
     // reset mode and phase
@@ -883,6 +1383,104 @@ void GameEngine::gameReset() {
     cout << "Game was reset successfully" << endl;
 }
 
+void GameEngine::setCommandProcessor(CommandProcessor *commandProcessor) {
+    if(this->commandProcessor.get() != commandProcessor) {
+        this->commandProcessor.reset(commandProcessor);
+    }
+    // the engine only looks at the last command, the list of commands does not need to grow with the session
+    if(commandProcessor != nullptr && commandProcessor->getHistoryLimit() == 0) {
+        commandProcessor->setHistoryLimit(COMMAND_HISTORY);
+    }
+}
+
+void GameEngine::setSeed(unsigned seed) {
+    fixedSeed = true;
+    baseSeed = seed;
+}
+
+void GameEngine::setRecordDirectory(string recordDirectory) {
+    this->recordDirectory = recordDirectory;
+}
+
+void GameEngine::setSweep(bool sweep) {
+    this->sweep = sweep;
+}
+
+void GameEngine::setShard(int shard, int numShards) {
+    shardIndex = shard - 1;
+    shardCount = numShards;
+}
+
+void GameEngine::setGameBudget(long milliseconds) {
+    gameBudget = milliseconds;
+}
+
+void GameEngine::setStalemateTurns(int turns) {
+    boardHistory.setStalemateTurns(turns);
+}
+
+void GameEngine::setTelemetryDirectory(string telemetryDirectory) {
+    this->telemetryDirectory = telemetryDirectory;
+}
+
+void GameEngine::setMemoryReport(bool memoryReport) {
+    this->memoryReport = memoryReport;
+}
+
+bool GameEngine::isWithinTournamentLimits(Command *command) {
+    return command->getMapList().size() >= 1 && command->getMapList().size() <= 5 && command->getplayerStrategiesList().size() >= 2  && command->getplayerStrategiesList().size() <= 4 && command->getNumOfGames() >= 1 && command->getNumOfGames() <= 5 && command->getNumOfTurns() >= 10 && command->getNumOfTurns() <= 50;
+}
+
+/**
+ * Starts the record of a game once its board is set up
+ */
+void GameEngine::startRecording() {
+    if (recordDirectory.empty() || map_ == nullptr) {
+        return;
+    }
+    vector<Player*> recordedPlayers = {neutralPlayer};
+    recordedPlayers.insert(recordedPlayers.end(), players_.begin(), players_.end());
+    string fileName = recordDirectory + "/game_" + to_string(numGamesStarted) + ".wzr";
+    recorder.reset(new GameRecorder(fileName, gameSeed, map_.get(), mapFileName, recordedPlayers));
+    if (recorder->isOpen()) {
+        map_->setTransferListener(recorder.get());
+        cout << "Recording the game in " << fileName << endl;
+    } else {
+        cout << "Unable to record the game in " << fileName << endl;
+        recorder.reset();
+    }
+}
+
+/**
+ * Writes the per-turn series of the game that just ended, when the games are measured
+ */
+void GameEngine::saveTelemetry() {
+    if (!telemetry.isActive()) {
+        return;
+    }
+    string fileName = telemetryDirectory + "/game_" + to_string(numGamesStarted) + ".csv";
+    if (telemetry.save(fileName)) {
+        cout << "Telemetry of the game written to " << fileName << endl;
+    } else {
+        cout << "Unable to write the telemetry of the game to " << fileName << endl;
+    }
+    telemetry.end();
+}
+
+/**
+ * Ends the record of the current game with its winner, if there is one
+ */
+void GameEngine::stopRecording() {
+    if (recorder == nullptr) {
+        return;
+    }
+    recorder->finish(playingOrder.size() == 1 ? playingOrder.at(0) : nullptr);
+    if (map_ != nullptr) {
+        map_->setTransferListener(nullptr);
+    }
+    recorder.reset();
+}
+
 void GameEngine::gamePlay() {
     Command *command = nullptr;
     string instruction;
@@ -902,6 +1500,9 @@ void GameEngine::gamePlay() {
             instruction = command->getInstruction();
             if(instruction == "eof") {
                 cout << "End of the list of commands!" << endl;
+            } else if(instruction == "stats") {
+                cout << Stats::report();
+                command->saveEffect("Statistics reported.");
             }
         } while(instruction != "quit" && instruction != "replay" && instruction != "eof");
 
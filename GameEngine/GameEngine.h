@@ -10,21 +10,31 @@
 #include "../Player/Player.h"
 #include "../Map/Map.h"
 #include "../CommandProcessing/CommandProcessing.h"
+#include "BoardHistory.h"
+#include "../Stats/GameTelemetry.h"
 #include <string>
 #include <iostream>
 #include <vector>
 #include <cstdlib>
 #include <ctime>
+#include <memory>
 using namespace std;
 class Player;
 class Map;
 class Territory;
 class Deck;
 class CommandProcessor;
+class Command;
 class PlayerStrategy;
+class DiplomacyMatrix;
+class GameRecorder;
+class TraceSpan;
+struct TournamentCheckpoint;
 
 enum class Phases{START, MAPLOADED, MAPVALIDATED, PLAYERSADDED, ASSIGNREINFORCEMENT, ISSUEORDERS, EXECUTEORDERS, WIN};
 enum class Modes{STARTUP, PLAY};
+// what the next call to GameEngine::step plays
+enum class GameStep{BEGINTURN, REINFORCEMENT, ISSUEORDERS, EXECUTEORDERS, ENDTURN, ENDGAME, OVER};
 
 class GameEngine: public Subject
 {
@@ -34,7 +44,9 @@ public:
     virtual ~GameEngine();
     GameEngine& operator = (GameEngine const &anotherGameEngine);
     friend ostream& operator << (ostream &stream, const GameEngine &gameEngine);
-    static void assignToNeutralPlayer(Territory* territory);
+    static void assignToNeutralPlayer(Territory* territory, bool quiet = false); //quiet: not counted nor recorded, see Map::transferTerritories
+    static Player* getNeutralPlayer();
+    static int getStrategyIndex(const Player *player); //index of the strategy of a player in strategyType, -1 if it has none
     const vector<Player *> &getPlayers();
     void addPlayersToList(Player* player);
     //////////////////////////////////////////////////Sarah GAME PLAY _____ PART 3
@@ -54,6 +66,85 @@ public:
     static vector<PlayerStrategy*>strategyType ;
     void gamePlay();
 
+    /**
+     * replaces the command processor the commands are read from, the game engine takes ownership of it
+     * and bounds its list of commands, unless it already is
+     */
+    void setCommandProcessor(CommandProcessor *commandProcessor);
+
+    /**
+     * makes the games reproducible: the n-th game played uses seed + n - 1 instead of the current time,
+     * and the game of map m, column g of a tournament of G games per map uses seed + m * G + g
+     */
+    void setSeed(unsigned seed);
+
+    /**
+     * every game played from now on is recorded in a file of this directory, so it can be replayed by GameReplay
+     */
+    void setRecordDirectory(string recordDirectory);
+
+    /**
+     * lifts the limits of the tournament command on the number of maps, strategies, games and turns
+     */
+    void setSweep(bool sweep);
+
+    /**
+     * tournaments only play the games of one shard of their table, and write their files under names of their own,
+     * so the shards of a sweep can be played by independent processes then merged
+     * @param shard number of the shard, from 1 to numShards
+     */
+    void setShard(int shard, int numShards);
+
+    /**
+     * tournaments print the heap in use and its peak for each game and each map, to keep sweeps within a memory budget
+     */
+    void setMemoryReport(bool memoryReport);
+    /**
+     * the games of tournaments taking longer than this end as a draw, see CellResult::TIME_BUDGET
+     * @param milliseconds 0 for no limit, the default
+     */
+    void setGameBudget(long milliseconds);
+    /**
+     * the games of tournaments stuck for this many turns, or back to a board seen before, end early as a draw,
+     * see BoardHistory
+     * @param turns 0 to play every game until its last turn, the default
+     */
+    void setStalemateTurns(int turns);
+    /**
+     * every tournament game played from now on writes its per-turn series to a CSV file of this directory,
+     * see GameTelemetry
+     */
+    void setTelemetryDirectory(string telemetryDirectory);
+
+    /**
+     * starts playing the current game step by step, see step
+     * @param turnCount turns already played, more than 0 for a game restored from a checkpoint
+     */
+    void startGame(int numberOfMaxTurns, int turnCount);
+    /**
+     * plays the next step of the game started by startGame: the start of a turn, one of its three phases, its end,
+     * or the end of the game once a player won, the last turn was played, the game is stuck or it was cancelled
+     * @return false once the game is over
+     */
+    bool step();
+    /**
+     * ends the game played step by step as a draw once its current turn is over
+     * @param reason reason of the draw, see CellResult
+     */
+    void cancelGame(const string &reason);
+    /**
+     * @param turnCount set to the number of turns played
+     * @param reason set to the way the game ended, see CellResult
+     * @return the name of the winner or "Draw", empty while the game is not over
+     */
+    string getGameResult(int &turnCount, string &reason) const;
+
+    /**
+     * name of a file written by one shard of a sweep, so shards run side by side do not overwrite each other's files
+     * @param shardIndex shard, from 0
+     */
+    static string shardFileName(const string &fileName, int shardIndex, int shardCount);
+
     // Iloggable
     virtual string stringToLog();
 
@@ -61,30 +152,72 @@ private:
     const int MIN_NUM_PLAYERS;
     const int MAX_NUM_PLAYERS;
     const string MAP_DIRECTORY;
+    static const string STATS_FILE; //statistics written at the end of a tournament
+    static const string CHECKPOINT_FILE; //progress of the tournament being played
+    static const string RESULTS_FILE; //results written at the end of a tournament
+    static const int CHECKPOINT_INTERVAL = 5; //turns between two checkpoints of a game in progress
+    static const size_t COMMAND_HISTORY = 64; //commands kept by the command processor
     static Player *neutralPlayer;
     vector<Player *> playingOrder;
     Phases *phase;
     Modes *mode;
     vector<Player*> players_;
-    Map* map_ ;
-    CommandProcessor *commandProcessor;
+    unique_ptr<Map> map_;
+    unique_ptr<CommandProcessor> commandProcessor;
+    DiplomacyMatrix *diplomacy; // truces negotiated between the players of the current game
+    string mapFileName; // path the current map was loaded from
+    bool fixedSeed;
+    unsigned baseSeed;
+    unsigned gameSeed; // seed of the random number generator for the current game
+    int numGamesStarted;
+    string recordDirectory; // empty when the games are not recorded
+    unique_ptr<GameRecorder> recorder; // record of the current game, nullptr when it is not recorded
+    TournamentCheckpoint *checkpoint; // progress of the tournament being played, nullptr outside of tournaments
+    string checkpointFile;
+    BoardHistory boardHistory; // boards of the game being played in a tournament, to end it early once it is stuck if enabled
+    bool sweep; // tournaments are not limited in size
+    int shardIndex; // shard of the tournaments played, from 0
+    int shardCount;
+    bool memoryReport; // tournaments report their heap use
+    unique_ptr<TraceSpan> phaseSpan; // span of the current phase while the engine is traced
+    long gameBudget; // milliseconds the games of tournaments may take, 0 for no limit
+    // the game played step by step
+    GameStep nextStep;
+    int maxTurns;
+    int turnCount;
+    string drawReason; // why the game ends early, empty while it goes on
+    string cancelReason; // empty while the game is not cancelled
+    string gameResult;
+    string gameEndReason;
+    unique_ptr<TraceSpan> turnSpan; // span of the current turn while the engine is traced
+    string telemetryDirectory; // empty when the series of the games are not written
+    GameTelemetry telemetry; // series of the game played step by step
     void printTitle();
-    void loadMap(string filename);
+    void loadMap(string filename, unique_ptr<Map> preloaded = nullptr);
     void validateMap(Phases *phase);
     void assignTerritories();
     void assignPlayingOrder();
+    void resetDiplomacy();
     void initialReinforcement();
     void initialCardDrawing();
     void printPlayPhaseGreeting();
     string modeToString(Modes mode);
     string phaseToString(Phases phase);
     void transition(Phases phaseToTransition);
-    string startupMapLoading(string map);
+    string startupMapLoading(string map, unique_ptr<Map> preloaded = nullptr);
     string startupMapValidation();
+    string reportMapValidation(int validation);
     string startupGameInitialization();
-    string tournamentPlay(int numberOfMaxTurns);
+    string tournamentPlay(int numberOfMaxTurns, int &turnCount, string &reason);
+    static bool isWithinTournamentLimits(Command *command);
+    void playTournament(TournamentCheckpoint &tournament, const string &checkpointFile);
+    void saveCheckpoint(int turn);
+    bool restoreGame(const TournamentCheckpoint &tournament);
     void gameReset();
     void printPlayerStrategy();
     void resetPlayerStrategy();
+    void startRecording();
+    void stopRecording();
+    void saveTelemetry();
 };
 #endif //COMP345_N11_GAMEENGINE_H
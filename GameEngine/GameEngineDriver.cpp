@@ -3,15 +3,164 @@
 //
 
 #include "GameEngineDriver.h"
+#include "../Replay/GameReplay.h"
+#include "TournamentResults.h"
+#include "../Stats/Trace.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
 
+namespace {
+    // seeks a turn of a game record, or replays the whole game from its start when no turn is given,
+    // then reports how fast it went
+    void playbackGameRecord(const string &fileName, int turn) {
+        GameReplay replay;
+        cout << "Replaying the game recorded in " << fileName << endl;
+        if (!replay.load(fileName)) {
+            return;
+        }
+        auto start = chrono::steady_clock::now();
+        if (turn >= 0 && turn <= replay.getNumTurns()) {
+            replay.seek(turn);
+        } else {
+            while (replay.step()) {}
+            turn = replay.getNumTurns();
+        }
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        cout << replay.describe();
+        cout << "Replayed " << replay.getNumOrdersReplayed() << " orders in " << seconds * 1000 << " ms";
+        if (seconds > 0) {
+            cout << " (" << static_cast<long>(replay.getNumOrdersReplayed() / seconds) << " orders/s)";
+        }
+        cout << endl;
+        if (turn == replay.getNumTurns() && replay.getRecordedSeconds() > 0) {
+            cout << "The recorded game took " << replay.getRecordedSeconds() * 1000 << " ms" << endl;
+            cout << (replay.matchesFinalSnapshot() ? "The replayed board matches the end of the recorded game"
+                                                   : "The replayed board differs from the end of the recorded game") << endl;
+        }
+    }
+
+    // prints the table and the aggregate statistics of the games of all the shards of a sweep
+    void mergeTournamentResults(const vector<string> &fileNames) {
+        vector<TournamentResults> shards(fileNames.size());
+        for (size_t i = 0; i < fileNames.size(); i++) {
+            if (!shards[i].load(fileNames[i])) {
+                cout << "Unable to read the tournament results of " << fileNames[i] << endl;
+                return;
+            }
+        }
+        TournamentResults merged;
+        string error;
+        if (!TournamentResults::merge(shards, merged, error)) {
+            cout << error << endl;
+            return;
+        }
+        cout << "Merged the results of " << fileNames.size() << " shards" << endl;
+        cout << "Tournament Result:\n" << merged.table() << endl << endl;
+        cout << merged.aggregates();
+    }
+}
+
+
+void GameEngineDriver(int argc, char* argv[]){
+    string replayFile;
+    size_t historyLimit = FileCommandProcessorAdapter::DEFAULT_STREAMING_HISTORY;
+    string recordDirectory;
+    string playbackFile;
+    int playbackTurn = -1;
+    bool fixedSeed = false;
+    unsigned seed = 0;
+    bool sweep = false;
+    bool memoryReport = false;
+    long gameBudget = 0;
+    int stalemateTurns = 0;
+    string telemetryDirectory;
+    string traceFile;
+    int shard = 1, numShards = 1;
+    vector<string> mergedFiles;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayFile = argv[++i];
+        } else if (strcmp(argv[i], "--history") == 0 && i + 1 < argc) {
+            historyLimit = strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            fixedSeed = true;
+            seed = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordDirectory = argv[++i];
+        } else if (strcmp(argv[i], "--playback") == 0 && i + 1 < argc) {
+            playbackFile = argv[++i];
+        } else if (strcmp(argv[i], "--turn") == 0 && i + 1 < argc) {
+            playbackTurn = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--sweep") == 0) {
+            sweep = true;
+        } else if (strcmp(argv[i], "--memory-report") == 0) {
+            memoryReport = true;
+        } else if (strcmp(argv[i], "--game-budget") == 0 && i + 1 < argc) {
+            gameBudget = strtol(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "--stalemate") == 0 && i + 1 < argc) {
+            stalemateTurns = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--telemetry") == 0 && i + 1 < argc) {
+            telemetryDirectory = argv[++i];
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            traceFile = argv[++i];
+        } else if (strcmp(argv[i], "--shard") == 0 && i + 1 < argc) {
+            if (sscanf(argv[++i], "%d/%d", &shard, &numShards) != 2 || numShards < 1 || shard < 1 || shard > numShards) {
+                cout << "Ignoring invalid shard " << argv[i] << ", expected <i>/<n> with 1 <= i <= n" << endl;
+                shard = numShards = 1;
+            }
+        } else if (strcmp(argv[i], "--merge") == 0) {
+            while (i + 1 < argc && strncmp(argv[i + 1], "--", 2) != 0) {
+                mergedFiles.push_back(argv[++i]);
+            }
+        } else {
+            cout << "Ignoring unknown option " << argv[i] << endl;
+        }
+    }
+
+    if (!playbackFile.empty()) {
+        playbackGameRecord(playbackFile, playbackTurn);
+        return;
+    }
+    if (!mergedFiles.empty()) {
+        mergeTournamentResults(mergedFiles);
+        return;
+    }
 
-void GameEngineDriver(){
     cout << "\n****************************************************************************" << endl;
     cout << "\t\tTesting Part 2" << endl;
     cout << "****************************************************************************" << endl;
     GameEngine *gameEngine = new GameEngine();
+    if (!replayFile.empty()) {
+        cout << "Replaying the commands of " << replayFile << endl;
+        gameEngine->setCommandProcessor(new FileCommandProcessorAdapter(replayFile, historyLimit));
+    }
+    if (fixedSeed) {
+        gameEngine->setSeed(seed);
+    }
+    if (!recordDirectory.empty()) {
+        gameEngine->setRecordDirectory(recordDirectory);
+    }
+    gameEngine->setSweep(sweep);
+    gameEngine->setShard(shard, numShards);
+    gameEngine->setMemoryReport(memoryReport);
+    gameEngine->setGameBudget(gameBudget);
+    gameEngine->setStalemateTurns(stalemateTurns);
+    if (!telemetryDirectory.empty()) {
+        gameEngine->setTelemetryDirectory(telemetryDirectory);
+    }
     LogObserver *logObserver = new LogObserver(gameEngine);
+    if (!traceFile.empty()) {
+        // the shards of a sweep trace to files of their own
+        traceFile = GameEngine::shardFileName(traceFile, shard - 1, numShards);
+        Trace::start(traceFile);
+    }
     gameEngine->gamePlay();
+    if (!traceFile.empty()) {
+        cout << (Trace::stop() ? "Trace written to " : "Unable to write the trace to ") << traceFile << endl;
+    }
 
     delete logObserver;
     delete gameEngine;
@@ -6,7 +6,21 @@
 #define COMP345_N11_GAMEENGINEDRIVER_H
 #include "GameEngine.h"
 
-void GameEngineDriver();
+/**
+ * plays the game from the commands of GECommands.txt
+ * command line options:
+ *   --replay <file>   streams the commands of a script instead, for long automated games
+ *   --history <n>     number of commands kept in memory during a replay
+ *   --seed <n>        seeds the games with n, n + 1, ... instead of the current time
+ *   --record <dir>    writes a game record of every game played in a directory
+ *   --playback <file> replays a game record instead of playing, without running the player strategies
+ *   --turn <n>        turn the playback stops at, the last one by default
+ *   --sweep           lifts the limits of the tournament command
+ *   --stalemate <k>   ends the tournament games where no territory changed hands for k turns as a draw
+ *   --shard <i>/<n>   plays only the i-th of n shares of the games of a tournament, e.g. --shard 2/8
+ *   --merge <files>   merges the result files written by the shards of a sweep instead of playing
+ */
+void GameEngineDriver(int argc = 0, char* argv[] = nullptr);
 
 
 #endif //COMP345_N11_GAMEENGINEDRIVER_H
@@ -0,0 +1,51 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "MapPrefetcher.h"
+#include "../Map/Map.h"
+#include "../Stats/Trace.h"
+
+MapPrefetcher::MapPrefetcher(const vector<string> &fileNames, const vector<bool> &needed)
+        : fileNames(fileNames), needed(needed), maps(fileNames.size()) {
+    prefetchAfter(-1);
+}
+
+MapPrefetcher::~MapPrefetcher() {
+    for (auto &map : maps) {
+        if (map.valid()) {
+            map.wait();
+        }
+    }
+}
+
+PrefetchedMap MapPrefetcher::take(int index) {
+    if (!maps[index].valid()) {
+        // taken out of order, loaded right away
+        maps[index] = async(launch::deferred, &MapPrefetcher::load, fileNames[index]);
+    }
+    PrefetchedMap map = maps[index].get();
+    prefetchAfter(index);
+    return map;
+}
+
+// starts loading the first needed map after index that is not loading yet
+void MapPrefetcher::prefetchAfter(int index) {
+    for (size_t i = index + 1; i < fileNames.size(); i++) {
+        if (needed[i]) {
+            if (!maps[i].valid()) {
+                maps[i] = async(launch::async, &MapPrefetcher::load, fileNames[i]);
+            }
+            return;
+        }
+    }
+}
+
+// runs on the thread of the prefetch, the map is only read by the games once it is handed over
+PrefetchedMap MapPrefetcher::load(const string &fileName) {
+    TraceSpan span("prefetch map", "map", "\"file\": \"" + Trace::escape(fileName) + "\"");
+    PrefetchedMap map;
+    map.map.reset(MapLoader::loadMapFile(fileName));
+    map.validation = map.map->validate();
+    return map;
+}
@@ -0,0 +1,60 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#ifndef COMP345_N11_MAPPREFETCHER_H
+#define COMP345_N11_MAPPREFETCHER_H
+
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+using namespace std;
+
+class Map;
+
+/**
+ * A map loaded and validated ahead of the games played on it.
+ */
+struct PrefetchedMap {
+    unique_ptr<Map> map;
+    int validation; //result of Map::validate, 0 for a valid map
+};
+
+/**
+ * Loads and validates the maps of a tournament on a background thread while the games of the previous map are played.
+ * The next map is started as soon as a map is taken, so at most one map is loaded ahead and a map file is never read
+ * by the games' thread. An invalid map is handed over like any other, with the result of its validation.
+ */
+class MapPrefetcher {
+public:
+    /**
+     * starts loading the first map needed
+     * @param fileNames paths of the maps, in the order they are played
+     * @param needed whether each map is played, the others are never loaded
+     */
+    MapPrefetcher(const vector<string> &fileNames, const vector<bool> &needed);
+    MapPrefetcher(const MapPrefetcher &anotherPrefetcher) = delete;
+    MapPrefetcher& operator = (const MapPrefetcher &anotherPrefetcher) = delete;
+
+    /**
+     * waits for the map still being loaded, if any
+     */
+    ~MapPrefetcher();
+
+    /**
+     * hands over a needed map, waiting for it if it is not ready yet, then starts loading the next needed map
+     * the maps have to be taken in order
+     */
+    PrefetchedMap take(int index);
+
+private:
+    vector<string> fileNames;
+    vector<bool> needed;
+    vector<future<PrefetchedMap>> maps;
+
+    void prefetchAfter(int index);
+    static PrefetchedMap load(const string &fileName);
+};
+
+#endif //COMP345_N11_MAPPREFETCHER_H
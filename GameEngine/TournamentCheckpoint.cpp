@@ -0,0 +1,265 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "TournamentCheckpoint.h"
+#include "../Replay/BinaryIO.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+namespace {
+    const char MAGIC[4] = {'W', 'Z', 'T', 'C'};
+    const uint32_t MAX_ENTRIES = 1 << 20; //bound on the sizes read from a file, well above anything a sweep uses
+
+    bool readStrings(BinaryReader &reader, vector<string> &values) {
+        uint32_t count;
+        if (!reader.read(count) || count > MAX_ENTRIES) {
+            return false;
+        }
+        values.resize(count);
+        for (auto &value : values) {
+            if (!reader.readString(value)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void writeStrings(BinaryWriter &writer, const vector<string> &values) {
+        writer.write(static_cast<uint32_t>(values.size()));
+        for (auto &value : values) {
+            writer.writeString(value);
+        }
+    }
+
+    bool readCells(BinaryReader &reader, vector<CellResult> &cells) {
+        uint32_t count;
+        if (!reader.read(count) || count > MAX_ENTRIES) {
+            return false;
+        }
+        cells.resize(count);
+        for (auto &cell : cells) {
+            uint32_t seed;
+            int32_t turns;
+            if (!reader.readString(cell.result) || !reader.read(seed) || !reader.read(turns) || !reader.readString(cell.reason)) {
+                return false;
+            }
+            cell.seed = seed;
+            cell.turns = turns;
+        }
+        return true;
+    }
+
+    void writeCells(BinaryWriter &writer, const vector<CellResult> &cells) {
+        writer.write(static_cast<uint32_t>(cells.size()));
+        for (auto &cell : cells) {
+            writer.writeString(cell.result);
+            writer.write(static_cast<uint32_t>(cell.seed));
+            writer.write(static_cast<int32_t>(cell.turns));
+            writer.writeString(cell.reason);
+        }
+    }
+}
+
+TournamentCheckpoint::TournamentCheckpoint() : numGames(0), maxTurns(0), fixedSeed(false), baseSeed(0),
+                                               numGamesStarted(0), shardIndex(0), shardCount(1), inGame(false), mapIndex(0), gameIndex(0), turn(0),
+                                               gameSeed(0), mapFingerprint(0), deckCards() {}
+
+bool TournamentCheckpoint::isComplete() const {
+    for (auto &mapResults : results) {
+        if (static_cast<int>(mapResults.size()) < numGames) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TournamentCheckpoint::save(const string &fileName) const {
+    BinaryWriter writer;
+    writer.writeBytes(MAGIC, sizeof(MAGIC));
+    writer.write(static_cast<uint32_t>(VERSION));
+    writeStrings(writer, maps);
+    writeStrings(writer, strategies);
+    writer.write(static_cast<int32_t>(numGames));
+    writer.write(static_cast<int32_t>(maxTurns));
+    writer.write(static_cast<uint8_t>(fixedSeed));
+    writer.write(static_cast<uint32_t>(baseSeed));
+    writer.write(static_cast<int32_t>(numGamesStarted));
+    writer.write(static_cast<int32_t>(shardIndex));
+    writer.write(static_cast<int32_t>(shardCount));
+    writer.write(static_cast<uint32_t>(results.size()));
+    for (auto &mapResults : results) {
+        writeCells(writer, mapResults);
+    }
+
+    writer.write(static_cast<uint8_t>(inGame));
+    if (inGame) {
+        writer.write(static_cast<int32_t>(mapIndex));
+        writer.write(static_cast<int32_t>(gameIndex));
+        writer.write(static_cast<int32_t>(turn));
+        writer.write(static_cast<uint32_t>(gameSeed));
+        writer.write(mapFingerprint);
+        writer.write(static_cast<uint32_t>(armies.size()));
+        writer.writeBytes(armies.data(), armies.size() * sizeof(int32_t));
+        writer.write(static_cast<uint32_t>(players.size()));
+        writer.writeBytes(players.data(), players.size() * sizeof(CheckpointPlayer));
+        for (auto &playerTerritories : territories) {
+            writer.write(static_cast<uint32_t>(playerTerritories.size()));
+            writer.writeBytes(playerTerritories.data(), playerTerritories.size() * sizeof(int32_t));
+        }
+        writer.write(static_cast<uint32_t>(playingOrder.size()));
+        writer.writeBytes(playingOrder.data(), playingOrder.size());
+        writer.writeBytes(deckCards, sizeof(deckCards));
+        writer.write(static_cast<uint32_t>(boardHashes.size()));
+        writer.writeBytes(ownershipHashes.data(), ownershipHashes.size() * sizeof(uint64_t));
+        writer.writeBytes(boardHashes.data(), boardHashes.size() * sizeof(uint64_t));
+    }
+    writer.write(fnv1a(writer.getBuffer().data(), writer.getBuffer().size()));
+
+    // write then rename: readers see either the previous checkpoint or the new one, never a partial file
+    string temporaryFileName = fileName + ".tmp";
+    {
+        ofstream file(temporaryFileName, ios::binary | ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        file.write(writer.getBuffer().data(), writer.getBuffer().size());
+        file.flush();
+        if (!file.good()) {
+            file.close();
+            remove(temporaryFileName.c_str());
+            return false;
+        }
+    }
+    if (rename(temporaryFileName.c_str(), fileName.c_str()) != 0) {
+        // some platforms refuse to rename over an existing file
+        remove(fileName.c_str());
+        if (rename(temporaryFileName.c_str(), fileName.c_str()) != 0) {
+            remove(temporaryFileName.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TournamentCheckpoint::load(const string &fileName) {
+    ifstream file(fileName, ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    string data((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+    if (data.size() < sizeof(MAGIC) + sizeof(uint64_t)) {
+        return false;
+    }
+    // the checksum covers everything before it
+    size_t contentSize = data.size() - sizeof(uint64_t);
+    uint64_t checksum;
+    memcpy(&checksum, data.data() + contentSize, sizeof(checksum));
+    if (checksum != fnv1a(data.data(), contentSize)) {
+        return false;
+    }
+    data.resize(contentSize);
+    BinaryReader reader(data);
+
+    char magic[sizeof(MAGIC)];
+    uint32_t version, numResults;
+    int32_t numGames32, maxTurns32, numGamesStarted32, shardIndex32, shardCount32;
+    uint8_t fixedSeed8, inGame8;
+    uint32_t baseSeed32;
+    if (!reader.readBytes(magic, sizeof(magic)) || memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        !reader.read(version) || version != VERSION) {
+        return false;
+    }
+    if (!readStrings(reader, maps) || !readStrings(reader, strategies) || !reader.read(numGames32) ||
+        !reader.read(maxTurns32) || !reader.read(fixedSeed8) || !reader.read(baseSeed32) ||
+        !reader.read(numGamesStarted32) || !reader.read(shardIndex32) || !reader.read(shardCount32) ||
+        shardCount32 < 1 || shardIndex32 < 0 || shardIndex32 >= shardCount32 ||
+        !reader.read(numResults) || numResults != maps.size()) {
+        return false;
+    }
+    numGames = numGames32;
+    maxTurns = maxTurns32;
+    fixedSeed = fixedSeed8 != 0;
+    baseSeed = baseSeed32;
+    numGamesStarted = numGamesStarted32;
+    shardIndex = shardIndex32;
+    shardCount = shardCount32;
+    results.resize(numResults);
+    for (auto &mapResults : results) {
+        if (!readCells(reader, mapResults) || static_cast<int>(mapResults.size()) > numGames) {
+            return false;
+        }
+    }
+
+    if (!reader.read(inGame8)) {
+        return false;
+    }
+    inGame = inGame8 != 0;
+    if (inGame) {
+        int32_t mapIndex32, gameIndex32, turn32;
+        uint32_t gameSeed32, numTerritories, numPlayers, numPlaying;
+        if (!reader.read(mapIndex32) || !reader.read(gameIndex32) || !reader.read(turn32) || !reader.read(gameSeed32) ||
+            !reader.read(mapFingerprint) || !reader.read(numTerritories) ||
+            numTerritories > reader.remaining() / sizeof(int32_t)) {
+            return false;
+        }
+        armies.resize(numTerritories);
+        if (!reader.readBytes(armies.data(), armies.size() * sizeof(int32_t)) ||
+            !reader.read(numPlayers) || numPlayers != strategies.size() + 1) {
+            return false;
+        }
+        players.resize(numPlayers);
+        if (!reader.readBytes(players.data(), players.size() * sizeof(CheckpointPlayer))) {
+            return false;
+        }
+        // every territory is held by one player at most
+        vector<bool> held(numTerritories, false);
+        territories.resize(numPlayers);
+        for (auto &playerTerritories : territories) {
+            uint32_t numHeld;
+            if (!reader.read(numHeld) || numHeld > numTerritories) {
+                return false;
+            }
+            playerTerritories.resize(numHeld);
+            if (!reader.readBytes(playerTerritories.data(), playerTerritories.size() * sizeof(int32_t))) {
+                return false;
+            }
+            for (auto territory : playerTerritories) {
+                if (territory < 0 || territory >= static_cast<int32_t>(numTerritories) || held[territory]) {
+                    return false;
+                }
+                held[territory] = true;
+            }
+        }
+        if (!reader.read(numPlaying) || numPlaying > numPlayers) {
+            return false;
+        }
+        playingOrder.resize(numPlaying);
+        uint32_t numBoards;
+        if (!reader.readBytes(playingOrder.data(), playingOrder.size()) || !reader.readBytes(deckCards, sizeof(deckCards)) ||
+            !reader.read(numBoards) || numBoards > reader.remaining() / (2 * sizeof(uint64_t))) {
+            return false;
+        }
+        ownershipHashes.resize(numBoards);
+        boardHashes.resize(numBoards);
+        if (!reader.readBytes(ownershipHashes.data(), ownershipHashes.size() * sizeof(uint64_t)) ||
+            !reader.readBytes(boardHashes.data(), boardHashes.size() * sizeof(uint64_t))) {
+            return false;
+        }
+        mapIndex = mapIndex32;
+        gameIndex = gameIndex32;
+        turn = turn32;
+        gameSeed = gameSeed32;
+        if (mapIndex < 0 || mapIndex >= static_cast<int>(maps.size()) ||
+            gameIndex != static_cast<int>(results[mapIndex].size()) || turn < 0) {
+            return false;
+        }
+        for (auto player : playingOrder) {
+            if (player >= numPlayers) {
+                return false;
+            }
+        }
+    }
+    return reader.remaining() == 0;
+}
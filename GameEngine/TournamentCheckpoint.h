@@ -0,0 +1,78 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#ifndef COMP345_N11_TOURNAMENTCHECKPOINT_H
+#define COMP345_N11_TOURNAMENTCHECKPOINT_H
+
+#include "../Cards/Cards.h"
+#include "TournamentResults.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * State of a player of the game in progress when a checkpoint was taken.
+ */
+struct CheckpointPlayer {
+    uint8_t strategy; //index in GameEngine::strategyType, NO_STRATEGY if the player has none
+    uint8_t playing; //1 if the player is still in the playing order
+    int32_t reinforcementPool;
+    int32_t cards[NUM_CARD_TYPES];
+};
+
+/**
+ * Progress of a tournament: its parameters, the results of the games already played and, when a game is in
+ * progress, the board and the players at the end of its last checkpointed turn.
+ * Checkpoints are written to a versioned binary file ending with a checksum. The file is written next to its
+ * destination then renamed over it, so a crash while saving leaves the previous checkpoint intact.
+ */
+struct TournamentCheckpoint {
+    static const uint32_t VERSION = 3;
+    static const uint8_t NO_STRATEGY = 0xFF;
+
+    // tournament
+    vector<string> maps;
+    vector<string> strategies;
+    int numGames;
+    int maxTurns;
+    bool fixedSeed;
+    unsigned baseSeed;
+    int numGamesStarted;
+    int shardIndex; //shard of a sweep the tournament is, see TournamentResults
+    int shardCount;
+    vector<vector<CellResult>> results; //results of the games already played or left to other shards, by map
+
+    // game in progress
+    bool inGame;
+    int mapIndex;
+    int gameIndex;
+    int turn; //last turn played
+    unsigned gameSeed;
+    uint64_t mapFingerprint;
+    vector<int32_t> armies; //armies of each territory of the map
+    vector<CheckpointPlayer> players; //the neutral player followed by the players of the tournament
+    vector<vector<int32_t>> territories; //territories of each player, in the order the player lists them
+    vector<uint8_t> playingOrder;
+    int32_t deckCards[NUM_CARD_TYPES];
+    vector<uint64_t> ownershipHashes; //boards of the game so far, see BoardHistory
+    vector<uint64_t> boardHashes;
+
+    TournamentCheckpoint();
+
+    /**
+     * writes the checkpoint atomically
+     * @return false if the file could not be written, the previous checkpoint is then left untouched
+     */
+    bool save(const string &fileName) const;
+
+    /**
+     * @return false if the file is missing, of another version, truncated or corrupted
+     */
+    bool load(const string &fileName);
+
+    bool isComplete() const; //whether all the games of the tournament were played
+};
+
+#endif //COMP345_N11_TOURNAMENTCHECKPOINT_H
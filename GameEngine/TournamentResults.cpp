@@ -0,0 +1,237 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "TournamentResults.h"
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace {
+    const char *MAGIC = "WZTR";
+    const int VERSION = 2;
+    const int MAX_TABLE_CELL_LENGTH = 25;
+    const char *DRAW = "Draw";
+
+    string pad(string text) {
+        if (text.length() < MAX_TABLE_CELL_LENGTH) {
+            text.append(MAX_TABLE_CELL_LENGTH - text.length(), ' ');
+        }
+        return text;
+    }
+
+    string percent(int count, int total) {
+        ostringstream buffer;
+        buffer << fixed << setprecision(1) << (total > 0 ? 100.0 * count / total : 0.0) << "%";
+        return buffer.str();
+    }
+
+    bool readLines(istream &file, int count, vector<string> &lines) {
+        lines.resize(count);
+        for (auto &line : lines) {
+            if (!getline(file, line)) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+const char *TournamentResults::UNPLAYED = "-";
+const char *CellResult::CONQUEST = "conquest";
+const char *CellResult::MAX_TURNS = "turns";
+const char *CellResult::STALEMATE = "stalemate";
+const char *CellResult::REPETITION = "repetition";
+const char *CellResult::TIME_BUDGET = "budget";
+
+bool CellResult::isPlayed() const {
+    return !result.empty();
+}
+
+string CellResult::describe() const {
+    if (reason == STALEMATE || reason == REPETITION || reason == TIME_BUDGET) {
+        return result + " (" + reason + ")";
+    }
+    return result;
+}
+
+TournamentResults::TournamentResults() : numGames(0), maxTurns(0), shardIndex(0), shardCount(1) {}
+
+bool TournamentResults::isInShard(int cell, int shardIndex, int shardCount) {
+    return shardCount <= 1 || cell % shardCount == shardIndex;
+}
+
+// one line per played game, the other cells are implicit
+bool TournamentResults::save(const string &fileName) const {
+    ofstream file(fileName, ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    file << MAGIC << " " << VERSION << "\n";
+    file << "shard " << shardIndex + 1 << " of " << shardCount << "\n";
+    file << "games " << numGames << "\n";
+    file << "turns " << maxTurns << "\n";
+    file << "maps " << maps.size() << "\n";
+    for (auto &map : maps) {
+        file << map << "\n";
+    }
+    file << "strategies " << strategies.size() << "\n";
+    for (auto &strategy : strategies) {
+        file << strategy << "\n";
+    }
+    file << "cells\n";
+    for (size_t i = 0; i < cells.size(); i++) {
+        for (size_t j = 0; j < cells[i].size(); j++) {
+            if (cells[i][j].isPlayed()) {
+                file << i << " " << j << " " << cells[i][j].seed << " " << cells[i][j].turns << " " << cells[i][j].reason << " " << cells[i][j].result << "\n";
+            }
+        }
+    }
+    return file.good();
+}
+
+bool TournamentResults::load(const string &fileName) {
+    ifstream file(fileName);
+    if (!file.is_open()) {
+        return false;
+    }
+    string magic, word, of;
+    int version, numMaps, numStrategies;
+    if (!(file >> magic >> version) || magic != MAGIC || version != VERSION ||
+        !(file >> word >> shardIndex >> of >> shardCount) || word != "shard" || of != "of" ||
+        shardCount < 1 || shardIndex < 1 || shardIndex > shardCount ||
+        !(file >> word >> numGames) || word != "games" || numGames < 1 ||
+        !(file >> word >> maxTurns) || word != "turns" ||
+        !(file >> word >> numMaps) || word != "maps" || numMaps < 1) {
+        return false;
+    }
+    shardIndex--;
+    file.ignore(numeric_limits<streamsize>::max(), '\n');
+    if (!readLines(file, numMaps, maps) || !(file >> word >> numStrategies) || word != "strategies" || numStrategies < 1) {
+        return false;
+    }
+    file.ignore(numeric_limits<streamsize>::max(), '\n');
+    if (!readLines(file, numStrategies, strategies) || !(file >> word) || word != "cells") {
+        return false;
+    }
+
+    cells.assign(numMaps, vector<CellResult>(numGames, CellResult()));
+    int map, game;
+    CellResult cell;
+    while (file >> map >> game >> cell.seed >> cell.turns >> cell.reason && getline(file >> ws, cell.result)) {
+        if (map < 0 || map >= numMaps || game < 0 || game >= numGames || cell.result.empty() ||
+            cells[map][game].isPlayed() || !isInShard(map * numGames + game, shardIndex, shardCount)) {
+            return false;
+        }
+        cells[map][game] = cell;
+    }
+    return file.eof();
+}
+
+string TournamentResults::formatTable(const vector<vector<CellResult>> &cells, int numGames, int numRows) {
+    string table = string(MAX_TABLE_CELL_LENGTH, ' ');
+    for (int j = 0; j < numGames; j++) {
+        table += " | " + pad("Game " + to_string(j + 1));
+    }
+    for (int i = 0; i < numRows && i < static_cast<int>(cells.size()); i++) {
+        table += "\n" + pad("Map " + to_string(i + 1));
+        for (auto &cell : cells[i]) {
+            table += " | " + pad(cell.isPlayed() ? cell.describe() : UNPLAYED);
+        }
+    }
+    return table;
+}
+
+string TournamentResults::table() const {
+    return formatTable(cells, numGames, static_cast<int>(cells.size()));
+}
+
+string TournamentResults::aggregates() const {
+    vector<string> players;
+    for (size_t i = 0; i < strategies.size(); i++) {
+        players.push_back("Player" + to_string(i + 1) + "_" + strategies[i]);
+    }
+    int numPlayed = 0, numDraws = 0, numStalemates = 0, numRepetitions = 0;
+    long totalTurns = 0;
+    vector<int> wins(players.size(), 0);
+    ostringstream byMap;
+    for (size_t i = 0; i < cells.size(); i++) {
+        vector<int> mapWins(players.size(), 0);
+        int mapDraws = 0;
+        for (auto &cell : cells[i]) {
+            if (!cell.isPlayed()) {
+                continue;
+            }
+            numPlayed++;
+            totalTurns += cell.turns;
+            if (cell.result == DRAW) {
+                numDraws++;
+                mapDraws++;
+                numStalemates += cell.reason == CellResult::STALEMATE;
+                numRepetitions += cell.reason == CellResult::REPETITION;
+            }
+            for (size_t k = 0; k < players.size(); k++) {
+                if (cell.result == players[k]) {
+                    wins[k]++;
+                    mapWins[k]++;
+                }
+            }
+        }
+        byMap << "  Map " << i + 1 << " (" << maps[i] << "):";
+        for (size_t k = 0; k < players.size(); k++) {
+            if (mapWins[k] > 0) {
+                byMap << " " << players[k] << " " << mapWins[k] << ",";
+            }
+        }
+        byMap << " " << DRAW << " " << mapDraws << endl;
+    }
+
+    ostringstream buffer;
+    buffer << "Games played: " << numPlayed << " of " << cells.size() * numGames << endl;
+    buffer << "Draws: " << numDraws << " (" << percent(numDraws, numPlayed) << "), ended early by "
+           << CellResult::STALEMATE << ": " << numStalemates << ", by " << CellResult::REPETITION << ": " << numRepetitions << endl;
+    buffer << "Average game length: " << fixed << setprecision(1)
+           << (numPlayed > 0 ? static_cast<double>(totalTurns) / numPlayed : 0.0) << " turns" << endl;
+    buffer << "Wins by player:" << endl;
+    for (size_t k = 0; k < players.size(); k++) {
+        buffer << "  " << left << setw(MAX_TABLE_CELL_LENGTH) << players[k] << right << setw(6) << wins[k]
+               << " (" << percent(wins[k], numPlayed) << ")" << endl;
+    }
+    buffer << "Wins by map:" << endl << byMap.str();
+    return buffer.str();
+}
+
+bool TournamentResults::merge(const vector<TournamentResults> &shards, TournamentResults &merged, string &error) {
+    if (shards.empty()) {
+        error = "No results to merge.";
+        return false;
+    }
+    merged = shards.front();
+    merged.shardIndex = 0;
+    merged.shardCount = 1;
+    for (auto &row : merged.cells) {
+        row.assign(merged.numGames, CellResult());
+    }
+    for (size_t s = 0; s < shards.size(); s++) {
+        const TournamentResults &shard = shards[s];
+        if (shard.maps != merged.maps || shard.strategies != merged.strategies || shard.numGames != merged.numGames ||
+            shard.maxTurns != merged.maxTurns || shard.shardCount != shards.front().shardCount) {
+            error = "The results " + to_string(s + 1) + " are not part of the same sweep as the first ones.";
+            return false;
+        }
+        for (size_t i = 0; i < shard.cells.size(); i++) {
+            for (int j = 0; j < shard.numGames; j++) {
+                if (!shard.cells[i][j].isPlayed()) {
+                    continue;
+                }
+                if (merged.cells[i][j].isPlayed()) {
+                    error = "Game " + to_string(j + 1) + " of map " + to_string(i + 1) + " appears in more than one of the results.";
+                    return false;
+                }
+                merged.cells[i][j] = shard.cells[i][j];
+            }
+        }
+    }
+    return true;
+}
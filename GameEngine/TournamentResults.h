@@ -0,0 +1,84 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#ifndef COMP345_N11_TOURNAMENTRESULTS_H
+#define COMP345_N11_TOURNAMENTRESULTS_H
+
+#include <string>
+#include <vector>
+using namespace std;
+
+/**
+ * Outcome of one game of a tournament, a cell of the result table.
+ */
+struct CellResult {
+    // how a game ended
+    static const char *CONQUEST; //a player took every territory
+    static const char *MAX_TURNS; //draw after the last turn of the tournament
+    static const char *STALEMATE; //draw once no territory changed hands for a while, see BoardHistory
+    static const char *REPETITION; //draw once the same board came back, see BoardHistory
+    static const char *TIME_BUDGET; //draw once the game used up its time budget, see GameEngine::setGameBudget
+
+    string result; //name of the winner or "Draw", empty when the game is left to another shard
+    unsigned seed;
+    int turns;
+    string reason; //one of the ways a game ends above
+
+    bool isPlayed() const;
+
+    /**
+     * @return the result, with the reason of a draw that ended the game early
+     */
+    string describe() const;
+};
+
+/**
+ * Results of a tournament, or of the games of a tournament played by one shard of a sweep.
+ * The games form a table with a row per map and a column per game. Cell c = map * games + game is played by
+ * shard c % shardCount, so shards interleave over the maps and each one gets a fair share of the small and large maps.
+ * Results are saved as text files, one per shard, combined by merge.
+ */
+struct TournamentResults {
+    static const char *UNPLAYED; //shown in the table for a game played by another shard
+
+    vector<string> maps;
+    vector<string> strategies;
+    int numGames;
+    int maxTurns;
+    int shardIndex; //from 0
+    int shardCount;
+    vector<vector<CellResult>> cells; //a row of numGames cells per map
+
+    TournamentResults();
+
+    static bool isInShard(int cell, int shardIndex, int shardCount);
+
+    bool save(const string &fileName) const;
+
+    /**
+     * @return false if the file is missing, of another version or malformed
+     */
+    bool load(const string &fileName);
+
+    /**
+     * the table printed at the end of a tournament
+     * @param numRows number of maps the table shows, the maps after them were not played
+     */
+    static string formatTable(const vector<vector<CellResult>> &cells, int numGames, int numRows);
+    string table() const;
+
+    /**
+     * games played, draws and their reasons, average length of the games, and wins by player and by map
+     */
+    string aggregates() const;
+
+    /**
+     * combines the results of the shards of a sweep
+     * @param error set to the reason the shards cannot be merged
+     * @return false if the shards are of different sweeps or a game was played by two of them
+     */
+    static bool merge(const vector<TournamentResults> &shards, TournamentResults &merged, string &error);
+};
+
+#endif //COMP345_N11_TOURNAMENTRESULTS_H
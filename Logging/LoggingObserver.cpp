@@ -3,19 +3,47 @@
 //
 
 #include "LoggingObserver.h"
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+    // observers of every observed subject, built on first use so subjects can be created during static initialization
+    unordered_map<const Subject*, list<Observer*>> &observerRegistry() {
+        static unordered_map<const Subject*, list<Observer*>> registry;
+        return registry;
+    }
+
+    mutex &registryMutex() {
+        static mutex registryMutex;
+        return registryMutex;
+    }
+}
 
 /**
- * create a list of observers
+ * a new subject has no observer and allocates nothing
  */
-Subject::Subject(){
-    _observers = new list<Observer*>;
+Subject::Subject() : _observed(false) {
 }
 
 /**
- * clear list of observers
+ * the observers of a subject are not copied
+ */
+Subject::Subject(const Subject &s) : contentToLog(s.contentToLog), _observed(false) {
+}
+
+Subject &Subject::operator=(const Subject &s) {
+    contentToLog = s.contentToLog;
+    return *this;
+}
+
+/**
+ * remove the subject from the registry
  */
 Subject::~Subject(){
-    delete _observers;
+    if (_observed) {
+        lock_guard<mutex> lock(registryMutex());
+        observerRegistry().erase(this);
+    }
 }
 
 /**
@@ -23,7 +51,9 @@ Subject::~Subject(){
  * @param o
  */
 void Subject::attach(Observer* o){
-    _observers->push_back(o);
+    lock_guard<mutex> lock(registryMutex());
+    observerRegistry()[this].push_back(o);
+    _observed = true;
 };
 
 /**
@@ -31,15 +61,44 @@ void Subject::attach(Observer* o){
  * @param o
  */
 void Subject::detach(Observer* o){
-    _observers->remove(o);
+    if (!_observed) {
+        return;
+    }
+    lock_guard<mutex> lock(registryMutex());
+    auto found = observerRegistry().find(this);
+    if (found == observerRegistry().end()) {
+        return;
+    }
+    found->second.remove(o);
+    if (found->second.empty()) {
+        observerRegistry().erase(found);
+        _observed = false;
+    }
 };
 
+bool Subject::isObserved() const {
+    return _observed;
+}
+
 /**
  * notify -> call update() on all observers
+ * the observers are copied first, so they may detach themselves while being notified
  */
 void Subject::notify(){
-    list<Observer *>::iterator i = _observers->begin();
-    for (; i != _observers->end(); ++i)
+    if (!_observed) {
+        return;
+    }
+    list<Observer *> observers;
+    {
+        lock_guard<mutex> lock(registryMutex());
+        auto found = observerRegistry().find(this);
+        if (found == observerRegistry().end()) {
+            return;
+        }
+        observers = found->second;
+    }
+    list<Observer *>::iterator i = observers.begin();
+    for (; i != observers.end(); ++i)
         (*i)->update(this);
 };
 
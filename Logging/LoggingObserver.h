@@ -25,16 +25,24 @@ public:
     virtual string stringToLog() = 0;
 };
 
+/**
+ * The observers of all the subjects are kept in one registry, so a subject nobody observes carries no allocation.
+ * Callers building a costly contentToLog should check isObserved() first.
+ * A copy of a subject starts without any observer.
+ */
 class Subject : public Iloggable{
 public:
     string contentToLog;
     Subject();
+    Subject(const Subject& s);
+    Subject& operator =(const Subject& s);
     ~Subject();
     virtual void attach(Observer* o);
     virtual void detach(Observer* o);
     virtual void notify();
+    bool isObserved() const; //O(1), without looking up the registry
 private:
-    list<Observer*> * _observers;
+    bool _observed;
 };
 
 
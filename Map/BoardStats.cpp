@@ -0,0 +1,141 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "BoardStats.h"
+#include "Map.h"
+#include "../Stats/Stats.h"
+#include <unordered_map>
+
+namespace {
+    const PlayerBoardStats NO_STATS = {0, 0, nullptr, 0, 0, 0};
+    const int UNSET = -2; //continent slot before the sweep met any of its territories
+}
+
+// mirrors the owners and armies of the territories of the map, the statistics are computed when first read
+BoardStats::BoardStats(Map *map) : map(map), stale(true) {
+    numTerritories = map->getNumTerritories();
+    numContinents = map->getNumContinent();
+    Territory** territories = map->getTerritories();
+    Continent** continents = map->getContinent();
+    unordered_map<const Continent*, int> continentIndex;
+    for (int i = 0; i < numContinents; i++) {
+        continentBonuses.push_back(continents != nullptr && continents[i] != nullptr ? continents[i]->getBonus() : 0);
+        if (continents != nullptr && continents[i] != nullptr) {
+            continentIndex[continents[i]] = i;
+        }
+    }
+    ownerSlots.assign(numTerritories, -1);
+    armies.assign(numTerritories, 0);
+    continentIndexes.assign(numTerritories, -1);
+    for (int i = 0; i < numTerritories; i++) {
+        Territory* territory = territories != nullptr ? territories[i] : nullptr;
+        if (territory == nullptr) {
+            continue;
+        }
+        auto found = continentIndex.find(territory->getContinent());
+        continentIndexes[i] = found != continentIndex.end() ? found->second : -1;
+        ownerSlots[i] = slotOf(territory->getOwner());
+        armies[i] = territory->getNumberOfArmies();
+    }
+}
+
+const PlayerBoardStats &BoardStats::of(Player *player) {
+    if (stale) {
+        sweep();
+    }
+    for (size_t slot = 0; slot < players.size(); slot++) {
+        if (players[slot] == player) {
+            return stats[slot];
+        }
+    }
+    return NO_STATS;
+}
+
+void BoardStats::armiesChanged(Territory *territory) {
+    int index = indexOf(territory);
+    if (index >= 0) {
+        armies[index] = territory->getNumberOfArmies();
+        stale = true;
+    }
+}
+
+void BoardStats::ownerChanged(Territory *territory) {
+    int index = indexOf(territory);
+    if (index >= 0) {
+        ownerSlots[index] = slotOf(territory->getOwner());
+        stale = true;
+    }
+}
+
+// position of a territory in the map's list of territories, -1 if the territory is not part of this map
+int BoardStats::indexOf(const Territory *territory) const {
+    if (territory == nullptr) {
+        return -1;
+    }
+    int index = territory->getId() - 1;
+    if (index < 0 || index >= numTerritories || map->getTerritories()[index] != territory) {
+        return -1;
+    }
+    return index;
+}
+
+// a game has a handful of players, so a linear search beats hashing
+// the slot of a player that left the game is kept, no territory refers to it anymore
+int BoardStats::slotOf(Player *player) {
+    if (player == nullptr) {
+        return -1;
+    }
+    for (size_t slot = 0; slot < players.size(); slot++) {
+        if (players[slot] == player) {
+            return static_cast<int>(slot);
+        }
+    }
+    players.push_back(player);
+    stats.push_back(NO_STATS);
+    return static_cast<int>(players.size()) - 1;
+}
+
+// one pass over the contiguous arrays computes the statistics of every player,
+// then one pass over the continents credits each continent to the slot owning all of its territories
+void BoardStats::sweep() {
+    for (auto &playerStats : stats) {
+        playerStats = NO_STATS;
+        playerStats.strongestArmies = -1;
+    }
+    continentSlots.assign(numContinents, UNSET);
+    vector<int> strongest(players.size(), -1);
+    const int* slots = ownerSlots.data();
+    const int* territoryArmies = armies.data();
+    for (int i = 0; i < numTerritories; i++) {
+        int slot = slots[i];
+        int continent = continentIndexes[i];
+        if (continent >= 0) {
+            int &continentSlot = continentSlots[continent];
+            continentSlot = continentSlot == UNSET || continentSlot == slot ? slot : -1;
+        }
+        if (slot < 0) {
+            continue;
+        }
+        PlayerBoardStats &playerStats = stats[slot];
+        playerStats.territories++;
+        playerStats.armies += territoryArmies[i];
+        if (territoryArmies[i] > playerStats.strongestArmies) {
+            playerStats.strongestArmies = territoryArmies[i];
+            strongest[slot] = i;
+        }
+    }
+    for (int c = 0; c < numContinents; c++) {
+        if (continentSlots[c] >= 0) {
+            stats[continentSlots[c]].continents++;
+            stats[continentSlots[c]].continentBonus += continentBonuses[c];
+        }
+    }
+    Territory** territories = map->getTerritories();
+    for (size_t slot = 0; slot < stats.size(); slot++) {
+        stats[slot].strongest = strongest[slot] >= 0 ? territories[strongest[slot]] : nullptr;
+        stats[slot].strongestArmies = max(stats[slot].strongestArmies, 0);
+    }
+    stale = false;
+    Stats::increment(StatCounter::BOARD_SWEEPS);
+}
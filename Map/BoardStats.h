@@ -0,0 +1,67 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#ifndef COMP345_N11_BOARDSTATS_H
+#define COMP345_N11_BOARDSTATS_H
+
+#include <vector>
+using namespace std;
+
+class Map;
+class Territory;
+class Player;
+
+/**
+ * Totals of one player over the board of a map.
+ */
+struct PlayerBoardStats {
+    int territories;
+    long armies;
+    Territory* strongest; //territory holding the most armies, the first one of the map on a tie, nullptr for none
+    int strongestArmies;
+    int continents; //continents the player owns all the territories of
+    int continentBonus; //sum of the bonuses of those continents
+};
+
+/**
+ * Per-player statistics of the board of a map: territory counts, army totals, strongest territory and continent control.
+ * The owner and the armies of every territory are mirrored in contiguous arrays, kept up to date by the map in O(1)
+ * per change, and the statistics of all the players are computed from them in a single sweep the first time they are
+ * read after the board changed. Reading them is then free until the next change, so a turn usually costs one sweep.
+ */
+class BoardStats {
+public:
+    explicit BoardStats(Map *map);
+    BoardStats(const BoardStats &anotherBoardStats) = delete;
+    BoardStats& operator = (const BoardStats &anotherBoardStats) = delete;
+
+    /**
+     * the statistics of a player, computed again first if the board changed since the last sweep
+     * @return the statistics, all zero for a player owning no territory of the map
+     */
+    const PlayerBoardStats& of(Player *player);
+
+    // updates sent by the map
+    void armiesChanged(Territory *territory);
+    void ownerChanged(Territory *territory);
+
+private:
+    Map* map;
+    int numTerritories;
+    int numContinents;
+    vector<Player*> players; //the owner of each slot, a player gets a slot the first time it owns a territory
+    vector<int> ownerSlots; //slot of the owner of each territory, -1 for none
+    vector<int> armies; //armies of each territory
+    vector<int> continentIndexes; //index of the continent of each territory, -1 for none
+    vector<int> continentBonuses;
+    vector<int> continentSlots; //used by the sweep, slot owning each continent
+    vector<PlayerBoardStats> stats; //one per slot
+    bool stale;
+
+    int indexOf(const Territory *territory) const;
+    int slotOf(Player *player);
+    void sweep();
+};
+
+#endif //COMP345_N11_BOARDSTATS_H
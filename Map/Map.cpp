@@ -3,6 +3,21 @@
 //
 
 #include "../Map/Map.h"
+#include "../Map/ThreatMap.h"
+#include "../Map/BoardStats.h"
+#include "../Map/NameTable.h"
+#include "../Stats/Stats.h"
+#include <algorithm>
+
+namespace {
+    // splitmix64 finalizer, it stands in for the usual table of random Zobrist keys since armies have no upper bound
+    uint64_t mix(uint64_t value) {
+        value += 0x9e3779b97f4a7c15ULL;
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+        return value ^ (value >> 31);
+    }
+}
 
 // MapLoader default constructor
 MapLoader::MapLoader() {
@@ -26,359 +41,162 @@ MapLoader::~MapLoader() {
 }
 
 // static function that reads a map file and returns a pointer to a map object
+// the file is only parsed by the first of the maps loaded from it that are alive at the same time
 Map* MapLoader::loadMapFile(std::string fileName) {
-    ifstream mapFile(fileName);
-    Map* map = new Map();
-    string line;
-    stringstream strStream;
-    regex regexSection("(\\[)(.+)(\\])");
-    smatch strMatch;
-    map->numContinents = 0;
-    map->numTerritories = 0;
-    int indexContinents = 0;
-    int indexCountries = 0;
-    int* borders = nullptr;
-    int* numCntryInContnt = nullptr;
-
-    // looping on map file twice:
-    // iter. no.1 - to get number of continents, territories ...
-    // iter. no.2 - to instantiate objects of continents, territories ...
-    for(int i = 0; i < 2; i++) {
-        bool readFlag(false);
-        bool regexFlag(false);
-        string section;
-        string prevSection;
-        int prevContntId = 1;
-        int cntryInContnt = 0;
-        if (mapFile.eof()) {
-            mapFile.clear();
-            mapFile.seekg(0, ifstream::beg);
-        }
-        while (!mapFile.eof() && !mapFile.fail()) {
-            getline(mapFile, line);
-
-            // get a section's name
-            regexFlag = regex_match(line, strMatch, regexSection);
-            if (regexFlag) {
-                prevSection = section;
-                section = strMatch[2].str();
-            }
-
-            // After end of each section in the first iteration
-            if (i==0 && line.length() == 0 && !section.empty()) {
-                // creating the map's list of continents
-                if (section == "continents") {
-                    if (map->numContinents > 0) {
-                        map->continents = new Continent*[map->numContinents];
-                        numCntryInContnt = new int[map->numContinents];
-                        for(int j = 0; j < map->numContinents; j++) {
-                            numCntryInContnt[j] = 0;
-                        }
-                    }
-                }
-
-                // creating the map's list of territories
-                else if (section == "countries") {
-                    if (map->numTerritories > 0) {
-                        map->territories = new Territory*[map->numTerritories];
-                        borders = new int[map->numTerritories];
-                        for (int j = 0; j < map->numTerritories; j++) {
-                            borders[j] = 0;
-                        }
-                    }
-                } else if (section == "borders") {
-                    // do nothing
-                }
-                // reset section
-                section = "";
-            }
-
-            // for lines in a section
-            if (!regexFlag && line.length() > 0 && !section.empty()) {
-                // reset StringStream object
-                strStream.str(line);
-                strStream.clear();
-
-                // if iter 1: count number of continents
-                // if iter 2: create Continent object when map-file's line is proper
-                if(section == "continents") {
-                    if(i==0) {
-                        map->numContinents++;
-                    } else {
-                        string name;
-                        int bonus;
-                        string color;
-                        if (strStream >> name >> bonus >> color) {
-                            map->continents[indexContinents] = new Continent(indexContinents+1, name, bonus);
-                        } else {
-                            map->continents[indexContinents] = nullptr;
-                        }
-                        indexContinents++;
-                    }
-                }
-
-                // if iter 1: count number of territories
-                // if iter 2: create Territory object when map-file's line is proper, add territories to their continents
-                else if(section == "countries") {
-                    if(i==0) {
-                        map->numTerritories++;
-                    } else {
-                        int id;
-                        string name;
-                        int continentId;
-                        int x, y;
-                        if (strStream >> id >> name >> continentId >> x >> y) {
-                            if (indexCountries == id - 1) {
-                                map->territories[indexCountries] = new Territory(id, name, 0, map->continents[continentId - 1]);
-                            } else {
-                                map->territories[indexCountries] = nullptr;
-                            }
-                        } else {
-                            map->territories[indexCountries] = nullptr;
-                        }
-                        indexCountries++;
-                        if (prevContntId == continentId) {
-                            cntryInContnt++;
-                        } else if (prevContntId != continentId) {
-                            if (prevContntId > 0) {
-                                numCntryInContnt[prevContntId-1] = cntryInContnt;
-                                cntryInContnt = 1;
-                            }
-                            prevContntId = continentId;
-                        }
-
-                        // adding territories to their continents
-                        if (indexCountries == map->numTerritories && continentId > 0) {
-                            numCntryInContnt[continentId-1] = cntryInContnt;
-                        }
-                        if (indexCountries == map->numTerritories) {
-                            for(int j = 0; j < map->numContinents; j++) {
-                                Territory** ter = new Territory*[numCntryInContnt[j]];
-                                for (int k = 0; k < numCntryInContnt[j]; k++) {
-                                    ter[k] = nullptr;
-                                }
-                                int index = 0;
-                                for (int k = 0; k < map->numTerritories; k++) {
-                                    if (map->territories[k]->continent->id == (j+1)){
-                                        ter[index++] = map->territories[k];
-                                    }
-                                }
-                                map->continents[j]->territories = ter;
-                                map->continents[j]->numTerritories = numCntryInContnt[j];
-                            }
-                        }
-                    }
-                }
-
-                // if iter 1: count number of borders
-                // if iter 2: create and populate list of adjacent territories for each territory when map-file's line is proper
-                else if(section == "borders") {
-                    int numBorders = 0;
-                    int adjTerId = -1;
-                    int terId = -1;
-                    strStream >> terId;
-                    if (terId > 0) {
-                        if (i == 0) {
-                            while(strStream >> adjTerId) {
-                                borders[terId - 1]++;
-                            }
-                        } else {
-                            Territory** adjTer = new Territory*[borders[terId-1]];
-                            for (int j = 0; j < borders[terId-1]; j++) {
-                                adjTer[j] = nullptr;
-                            }
-                            int index = 0;
-                            while(strStream >> adjTerId) {
-                                if (adjTerId > 0) {
-                                    adjTer[index++] = *(map->territories + adjTerId - 1);
-                                }
-                            }
-                            map->territories[terId-1]->adjTerritories = adjTer;
-                            map->territories[terId-1]->numAdjTerritories = borders[terId-1];
-                        }
-                    }
-                }
-            }
-        }
-    }
-
-    // deallocating memory
-    delete[] borders;
-    borders = nullptr;
-    delete[] numCntryInContnt;
-    numCntryInContnt = nullptr;
-
-    // closing map file
-    mapFile.close();
-
-    return map;
+    ScopedTimer timer(Stats::phase(StatPhase::MAP_LOADING));
+    return new Map(MapTopology::load(fileName));
 }
 
 // Map default constructor
 Map::Map() {
     territories = nullptr;
     continents = nullptr;
+    adjTerritories = nullptr;
+    continentTerritories = nullptr;
     numTerritories = 0;
     numContinents = 0;
+    threatMap = nullptr;
+    boardStats = nullptr;
+    epoch = 0;
+    transferListener = nullptr;
+    ownershipHash = 0;
+    armiesHash = 0;
+}
+
+// Map constructor for a new game on a map topology
+Map::Map(shared_ptr<const MapTopology> topology) : Map() {
+    this->topology = move(topology);
+    build();
 }
 
 // Map copy constructor
-Map::Map(Map const &anotherMap) {
-    territories = nullptr;
-    continents = nullptr;
-    numTerritories = anotherMap.numTerritories;
-    numContinents = anotherMap.numContinents;
+// the copy shares the topology and gets the armies of the other map, but no owner
+Map::Map(Map const &anotherMap) : Map(anotherMap.topology) {
+    for (int i = 0; i < numTerritories; i++) {
+        if (territories[i] != nullptr) {
+            territories[i]->numArmies = anotherMap.territories[i]->numArmies;
+        }
+    }
+    computeHashes();
+}
 
-    // copying list of territories
-    if (anotherMap.territories != nullptr && anotherMap.numTerritories > 0) {
-        territories = new Territory*[numTerritories];
+// overloading the assignment operator for Map
+Map& Map::operator = (Map const &anotherMap) {
+    if (this != &anotherMap) {
+        release();
+        topology = anotherMap.topology;
+        build();
         for (int i = 0; i < numTerritories; i++) {
-            territories[i] = new Territory(*(anotherMap.territories[i]));
+            if (territories[i] != nullptr) {
+                territories[i]->numArmies = anotherMap.territories[i]->numArmies;
+            }
         }
+        computeHashes();
     }
+    return *this;
+}
+
+// Map destructor
+Map::~Map() {
+    release();
+}
 
-    // copying list of continents
-    if (anotherMap.continents != nullptr && anotherMap.numContinents > 0) {
+// creates the territories and continents of this map from its topology, with no owner and no army
+void Map::build() {
+    if (topology == nullptr) {
+        return;
+    }
+    numTerritories = topology->getNumTerritories();
+    numContinents = topology->getNumContinents();
+
+    if (numContinents > 0) {
         continents = new Continent*[numContinents];
         for (int i = 0; i < numContinents; i++) {
-            continents[i] = new Continent(*(anotherMap.continents[i]));
+            continents[i] = nullptr;
+            if (topology->isContinentValid(i)) {
+                continents[i] = new Continent(i + 1, &topology->getContinentName(i), topology->getContinentBonus(i));
+            }
         }
     }
-    // linking adjacent territories, and territories with continents
-    if (anotherMap.territories != nullptr && anotherMap.numTerritories > 0 && anotherMap.continents != nullptr && anotherMap.numContinents > 0) {
-        for (int i = 0; i < numTerritories; i++) {
 
-            // associating adjacency
-            if (anotherMap.territories[i] != nullptr && anotherMap.territories[i]->adjTerritories != nullptr && anotherMap.territories[i]->numAdjTerritories > 0) {
-                for (int j = 0; j < anotherMap.territories[i]->numAdjTerritories; j++) {
-                    int idx = -1;
-                    for (int k = 0; k < anotherMap.numTerritories; k++) {
-                        if (anotherMap.territories[i]->adjTerritories[j] == anotherMap.territories[k]) {
-                            idx = k;
-                            break;
-                        }
-                    }
-                    if (idx > -1) {
-                        territories[i]->adjTerritories[j] = territories[idx];
-                    }
-                }
+    if (numTerritories > 0) {
+        territories = new Territory*[numTerritories];
+        for (int i = 0; i < numTerritories; i++) {
+            territories[i] = nullptr;
+            if (topology->isTerritoryValid(i)) {
+                int continent = topology->getTerritoryContinent(i);
+                territories[i] = new Territory(i + 1, &topology->getTerritoryName(i), continent >= 0 ? continents[continent] : nullptr);
             }
+        }
+    }
 
-            // linking territories to continents
-            if (anotherMap.territories[i] != nullptr && anotherMap.territories[i]->continent != nullptr) {
-                int idx = -1;
-                for (int j = 0; j < anotherMap.numContinents; j++) {
-                    if (anotherMap.territories[i]->continent == anotherMap.continents[j]) {
-                        idx = j;
-                        break;
-                    }
-                }
-                if (idx > -1) {
-                    territories[i]->continent = continents[idx];
-                }
+    // linking adjacent territories, the lists of all the territories share one block
+    adjTerritories = new Territory*[topology->getNumBorders()];
+    Territory** next = adjTerritories;
+    for (int i = 0; i < numTerritories; i++) {
+        if (territories[i] != nullptr && topology->hasBorders(i)) {
+            const int *adjacent = topology->getAdjTerritories(i);
+            territories[i]->adjTerritories = next;
+            territories[i]->numAdjTerritories = topology->getNumAdjTerritories(i);
+            for (int j = 0; j < territories[i]->numAdjTerritories; j++) {
+                *next++ = adjacent[j] >= 0 ? territories[adjacent[j]] : nullptr;
             }
         }
+    }
 
-        // linking continents to territories
-        for (int i = 0; i < anotherMap.numContinents; i++) {
-            if (anotherMap.continents[i] != nullptr && anotherMap.continents[i]->territories != nullptr && anotherMap.continents[i]->numTerritories > 0) {
-                for (int j = 0; j < anotherMap.continents[i]->numTerritories; j++) {
-                    int idx = -1;
-                    for (int k = 0; k < anotherMap.numTerritories; k++) {
-                        if (anotherMap.continents[i]->territories[j] == anotherMap.territories[k]) {
-                            idx = k;
-                            break;
-                        }
-                    }
-                    if (idx > -1) {
-                        continents[i]->territories[j] = territories[idx];
-                    }
-                }
+    // linking continents to territories, the same way
+    continentTerritories = new Territory*[topology->getNumContinentTerritories()];
+    next = continentTerritories;
+    for (int i = 0; i < numContinents; i++) {
+        if (continents[i] != nullptr) {
+            const vector<int> &members = topology->getContinentTerritories(i);
+            continents[i]->territories = next;
+            continents[i]->numTerritories = static_cast<int>(members.size());
+            for (int member : members) {
+                *next++ = member >= 0 ? territories[member] : nullptr;
             }
         }
     }
+    linkTerritoriesToMap();
+    computeHashes();
 }
 
-// overloading the assignment operator for Map
-Map& Map::operator = (Map const &anotherMap) {
-    territories = nullptr;
-    continents = nullptr;
-    numTerritories = anotherMap.numTerritories;
-    numContinents = anotherMap.numContinents;
-
-    // copying list of territories
-    if (anotherMap.territories != nullptr && anotherMap.numTerritories > 0) {
-        territories = new Territory*[numTerritories];
-        for (int i = 0; i < numTerritories; i++) {
-            territories[i] = new Territory(*(anotherMap.territories[i]));
-        }
+// deletes the territories and continents of this map
+void Map::release() {
+    // the threat map and the board statistics go first so that territories being deleted stop reporting changes to them
+    if (threatMap != nullptr) {
+        delete threatMap;
+        threatMap = nullptr;
     }
-
-    // copying list of continents
-    if (anotherMap.continents != nullptr && anotherMap.numContinents > 0) {
-        continents = new Continent*[numContinents];
-        for (int i = 0; i < numContinents; i++) {
-            continents[i] = new Continent(*(anotherMap.continents[i]));
-        }
+    if (boardStats != nullptr) {
+        delete boardStats;
+        boardStats = nullptr;
     }
-    // linking adjacent territories, and territories with continents
-    if (anotherMap.territories != nullptr && anotherMap.numTerritories > 0 && anotherMap.continents != nullptr && anotherMap.numContinents > 0) {
-        for (int i = 0; i < numTerritories; i++) {
 
-            // associating adjacency
-            if (anotherMap.territories[i] != nullptr && anotherMap.territories[i]->adjTerritories != nullptr && anotherMap.territories[i]->numAdjTerritories > 0) {
-                for (int j = 0; j < anotherMap.territories[i]->numAdjTerritories; j++) {
-                    int idx = -1;
-                    for (int k = 0; k < anotherMap.numTerritories; k++) {
-                        if (anotherMap.territories[i]->adjTerritories[j] == anotherMap.territories[k]) {
-                            idx = k;
-                            break;
-                        }
-                    }
-                    if (idx > -1) {
-                        territories[i]->adjTerritories[j] = territories[idx];
-                    }
-                }
-            }
-
-            // linking territories to continents
-            if (anotherMap.territories[i] != nullptr && anotherMap.territories[i]->continent != nullptr) {
-                int idx = -1;
-                for (int j = 0; j < anotherMap.numContinents; j++) {
-                    if (anotherMap.territories[i]->continent == anotherMap.continents[j]) {
-                        idx = j;
-                        break;
-                    }
-                }
-                if (idx > -1) {
-                    territories[i]->continent = continents[idx];
-                }
+    // the lists of adjacent territories and of continent territories belong to the map, they are detached before
+    // anything is deleted, so that the territories and continents do not delete them nor follow them
+    if (territories != nullptr && numTerritories > 0) {
+        for (int i = 0; i < numTerritories; i++) {
+            if (territories[i] != nullptr) {
+                territories[i]->map = nullptr;
+                territories[i]->adjTerritories = nullptr;
+                territories[i]->numAdjTerritories = 0;
             }
         }
-
-        // linking continents to territories
-        for (int i = 0; i < anotherMap.numContinents; i++) {
-            if (anotherMap.continents[i] != nullptr && anotherMap.continents[i]->territories != nullptr && anotherMap.continents[i]->numTerritories > 0) {
-                for (int j = 0; j < anotherMap.continents[i]->numTerritories; j++) {
-                    int idx = -1;
-                    for (int k = 0; k < anotherMap.numTerritories; k++) {
-                        if (anotherMap.continents[i]->territories[j] == anotherMap.territories[k]) {
-                            idx = k;
-                            break;
-                        }
-                    }
-                    if (idx > -1) {
-                        continents[i]->territories[j] = territories[idx];
-                    }
-                }
+    }
+    if (continents != nullptr && numContinents > 0) {
+        for (int i = 0; i < numContinents; i++) {
+            if (continents[i] != nullptr) {
+                continents[i]->territories = nullptr;
+                continents[i]->numTerritories = 0;
             }
         }
     }
-    return *this;
-}
+    delete[] adjTerritories;
+    adjTerritories = nullptr;
+    delete[] continentTerritories;
+    continentTerritories = nullptr;
 
-// Map destructor
-Map::~Map() {
     // deallocating territories
     if (territories != nullptr && numTerritories > 0) {
         for (int i = 0; i < numTerritories; i++) {
@@ -398,6 +216,12 @@ Map::~Map() {
         delete[] continents;
         continents = nullptr;
     }
+    numTerritories = 0;
+    numContinents = 0;
+    ownershipHash = 0;
+    armiesHash = 0;
+    ownerKeys.clear();
+    topology.reset();
 }
 
 // a method that checks whether a map is valid or not, and returns an int
@@ -406,6 +230,7 @@ Map::~Map() {
 //          2 if at least one continent in the map is not a connected sub-graph
 //          3 if at least one territory belongs to more than one continent
 int Map::validate() const {
+    ScopedTimer timer(Stats::phase(StatPhase::MAP_VALIDATION));
     // checking whether the map is a connected graphs by recursively trying to reach the starting territory
     for (int i = 0; i < numTerritories; i++) {
         if (territories != nullptr && territories[i] != nullptr) {
@@ -509,10 +334,11 @@ Territory::Territory() {
     adjTerritories = nullptr;
     continent = nullptr;
     owner = nullptr;
+    map = nullptr;
     numArmies = 0;
     id = -1;
     numAdjTerritories = 0;
-    name = "";
+    name = NameTable::intern("");
     pendingIncomingArmies = 0;
     pendingOutgoingArmies = 0;
 }
@@ -522,9 +348,24 @@ Territory::Territory(int id, string name, int armies, Continent* continent) {
     adjTerritories = nullptr;
     this->continent = continent;
     owner = nullptr;
+    map = nullptr;
     this->numArmies = armies;
     this->id = id;
     numAdjTerritories = 0;
+    this->name = NameTable::intern(name);
+    pendingIncomingArmies = 0;
+    pendingOutgoingArmies = 0;
+}
+
+// Territory constructor for the territories of a map, whose names are already interned
+Territory::Territory(int id, const string *name, Continent *continent) {
+    adjTerritories = nullptr;
+    this->continent = continent;
+    owner = nullptr;
+    map = nullptr;
+    numArmies = 0;
+    this->id = id;
+    numAdjTerritories = 0;
     this->name = name;
     pendingIncomingArmies = 0;
     pendingOutgoingArmies = 0;
@@ -535,6 +376,7 @@ Territory::Territory(Territory const &anotherTerritory) {
     id = anotherTerritory.id;
     name = anotherTerritory.name;
     owner = nullptr;
+    map = nullptr;
     numAdjTerritories = anotherTerritory.numAdjTerritories;
     numArmies = anotherTerritory.numArmies;
     continent = anotherTerritory.continent;
@@ -561,6 +403,7 @@ Territory& Territory::operator = (Territory const &anotherTerritory) {
     id = anotherTerritory.id;
     name = anotherTerritory.name;
     owner = nullptr;
+    map = nullptr;
     numAdjTerritories = anotherTerritory.numAdjTerritories;
     numArmies = anotherTerritory.numArmies;
     continent = anotherTerritory.continent;
@@ -627,9 +470,10 @@ Territory::~Territory() {
 
 // mutator that sets ownership of territory to a player
 void Territory::setOwner(Player *owner) {
+    Player* oldOwner = this->owner;
     this->owner = owner;
 
-    // set ownership of the containing continent when player owns all territories in a continent
+    // set ownership of the containing continent when player owns all territories in a continent, nobody owns it otherwise
     bool ownContinent = true;
     if (continent != nullptr) {
         for (int i = 0; i < continent->numTerritories; i++) {
@@ -638,9 +482,11 @@ void Territory::setOwner(Player *owner) {
                 break;
             }
         }
-        if (ownContinent) {
-            continent->owner = owner;
-        }
+        continent->owner = ownContinent ? owner : nullptr;
+    }
+
+    if (map != nullptr && oldOwner != owner) {
+        map->territoryOwnerChanged(this, oldOwner);
     }
 }
 
@@ -651,7 +497,11 @@ Player* Territory::getOwner() const {
 
 // mutator to set number of armies in territory
 void Territory::setNumberOfArmies(int newArmies) {
+    int oldArmies = numArmies;
     numArmies = newArmies;
+    if (map != nullptr && oldArmies != numArmies) {
+        map->territoryArmiesChanged(this, oldArmies);
+    }
 }
 
 // accessor to get number of armies in territory
@@ -669,7 +519,11 @@ void Territory::removeOwner() {
     if (continent != nullptr && continent->owner == owner) {
         continent->owner = nullptr;
     }
+    Player* oldOwner = owner;
     owner = nullptr;
+    if (map != nullptr && oldOwner != nullptr) {
+        map->territoryOwnerChanged(this, oldOwner);
+    }
 }
 
 // mutator that sets number and list of adjacent territories
@@ -683,7 +537,11 @@ void Territory::setAdjTerritories(int numAdjTer, Territory **adjTers) {
 
 // method that adds number of armies to territory
 void Territory::addArmies(int armies) {
+    int oldArmies = numArmies;
     numArmies += armies;
+    if (map != nullptr && oldArmies != numArmies) {
+        map->territoryArmiesChanged(this, oldArmies);
+    }
 }
 
 // accessor to get number of pending incoming armies
@@ -697,37 +555,53 @@ int Territory::getPendingOutgoingArmies() const {
 }
 
 // accessor to get name of territory
-string Territory::getName() const {
-    return name;
+const string &Territory::getName() const {
+    return *name;
 }
 
 // mutator to set number of pending incoming armies
 void Territory::setPendingIncomingArmies(int armies) {
     pendingIncomingArmies = armies;
+    if (map != nullptr) {
+        map->territoryPendingArmiesChanged(this);
+    }
 }
 
 // mutator to set number of pending outgoing armies
 void Territory::setPendingOutgoingArmies(int armies) {
     pendingOutgoingArmies = armies;
+    if (map != nullptr) {
+        map->territoryPendingArmiesChanged(this);
+    }
 }
 
 // function that removes number of armies from territory
 void Territory::removeArmies(int armies) {
+    int oldArmies = numArmies;
     numArmies -= armies;
     if (numArmies < 0)
     {
         numArmies = 0;
     }
+    if (map != nullptr && oldArmies != numArmies) {
+        map->territoryArmiesChanged(this, oldArmies);
+    }
 }
 
 // function that adds number of armies to pending incoming armies
 void Territory::addPendingIncomingArmies(int armies) {
     pendingIncomingArmies += armies;
+    if (map != nullptr) {
+        map->territoryPendingArmiesChanged(this);
+    }
 }
 
 // function that adds number of armies to pending outgoing armies
 void Territory::addPendingOutgoingArmies(int armies) {
     pendingOutgoingArmies += armies;
+    if (map != nullptr) {
+        map->territoryPendingArmiesChanged(this);
+    }
 }
 
 // Get the number of armies on the territory that are available for moving (advance/airlift).
@@ -744,7 +618,7 @@ Continent * Territory::getContinent() const {
 // Continent default constructor
 Continent::Continent() {
     id = -1;
-    name = "";
+    name = NameTable::intern("");
     bonus = 0;
     territories = nullptr;
     numTerritories = 0;
@@ -753,6 +627,16 @@ Continent::Continent() {
 
 // Continent parametrized constructor
 Continent::Continent(int id, string name, int bonus) {
+    this->id = id;
+    this->name = NameTable::intern(name);
+    this->bonus = bonus;
+    territories = nullptr;
+    numTerritories = 0;
+    owner = nullptr;
+}
+
+// Continent constructor for the continents of a map, whose names are already interned
+Continent::Continent(int id, const string *name, int bonus) {
     this->id = id;
     this->name = name;
     this->bonus = bonus;
@@ -829,8 +713,8 @@ void Continent::setTerritories(int numTers, Territory** ters) {
 }
 
 // accessor to get name of this continent
-string Continent::getName() const {
-    return string(name);
+const string &Continent::getName() const {
+    return *name;
 }
 
 
@@ -855,7 +739,7 @@ ostream& operator << (ostream &stream, const Map &map) {
 }
 
 ostream& operator << (ostream &stream, const Territory &territory) {
-    stream << "ID: " << territory.id << ", Name: " << territory.name << ", Number of armies: " << territory.numArmies;
+    stream << "ID: " << territory.id << ", Name: " << *territory.name << ", Number of armies: " << territory.numArmies;
     if (territory.continent != nullptr) {
         stream << ", Continent: " << territory.continent->getName();
     }
@@ -867,7 +751,7 @@ ostream& operator << (ostream &stream, const Territory &territory) {
         stream << ", adjacent territories are:";
         for (int i = 0; i < territory.numAdjTerritories; i++) {
             if (territory.adjTerritories[i] != nullptr) {
-                stream << "\n\t\t" << territory.adjTerritories[i]->name;
+                stream << "\n\t\t" << *territory.adjTerritories[i]->name;
                 if (i < territory.numAdjTerritories - 1) {
                     stream << ", ";
                 }
@@ -884,11 +768,16 @@ int Territory::getNumAdjTerritories() const {
 Territory **Territory::getAdjTerritories() const {
     return adjTerritories;
 }
+
+// accessor to the map this territory belongs to
+Map *Territory::getMap() const {
+    return map;
+}
 /////////////////////////////////////////////////////////////////////////////////
 
 
 ostream& operator << (ostream& stream, const Continent& continent) {
-    stream << "ID: " << continent.id << ", Name: " << continent.name << ", Number of territories: " << continent.numTerritories << ", Bonus: " << continent.bonus;
+    stream << "ID: " << continent.id << ", Name: " << *continent.name << ", Number of territories: " << continent.numTerritories << ", Bonus: " << continent.bonus;
     if (continent.owner != nullptr) {
         stream << ", Owner's Name: " << continent.owner->getName();
     }
@@ -940,4 +829,196 @@ int Map::getNumTerritories() {
 
 Territory **Map::getTerritories() const {
     return territories;
-}
\ No newline at end of file
+}
+
+// accessor to the read only part of the map
+const MapTopology *Map::getTopology() const {
+    return topology.get();
+}
+
+// looks the name up in the index of the topology instead of comparing it with every territory
+Territory *Map::findTerritory(const string &name) const {
+    int index = topology != nullptr ? topology->findTerritory(name) : -1;
+    return index >= 0 ? territories[index] : nullptr;
+}
+// sets this map as the owning map of all its territories so that they report their changes back to it
+void Map::linkTerritoriesToMap() {
+    if (territories != nullptr) {
+        for (int i = 0; i < numTerritories; i++) {
+            if (territories[i] != nullptr) {
+                territories[i]->map = this;
+            }
+        }
+    }
+}
+
+// accessor to the threat map of this map, which is built the first time it is requested
+ThreatMap *Map::getThreatMap() {
+    if (threatMap == nullptr) {
+        threatMap = new ThreatMap(this);
+    }
+    return threatMap;
+}
+
+// accessor to the board statistics of this map, which are built the first time they are requested
+BoardStats *Map::getBoardStats() {
+    if (boardStats == nullptr) {
+        boardStats = new BoardStats(this);
+    }
+    return boardStats;
+}
+
+// accessor to the hash of the owners and armies of the territories
+uint64_t Map::getBoardHash() const {
+    return ownershipHash ^ armiesHash;
+}
+
+// accessor to the hash of the owners of the territories
+uint64_t Map::getOwnershipHash() const {
+    return ownershipHash;
+}
+
+// key of a territory owned by a player, derived from the name of the player so that it is the same in every run
+// a territory without owner adds nothing to the hash
+uint64_t Map::ownerKey(const Territory *territory, const Player *owner) {
+    if (owner == nullptr) {
+        return 0;
+    }
+    uint64_t name = 0xcbf29ce484222325ULL;
+    for (char c : owner->getName()) {
+        name = (name ^ static_cast<unsigned char>(c)) * 0x100000001b3ULL;
+    }
+    return mix(~(static_cast<uint64_t>(territory->id) << 32) ^ name);
+}
+
+// key of a number of armies on a territory, an empty territory adds nothing to the hash
+uint64_t Map::armiesKey(const Territory *territory, int armies) {
+    if (armies == 0) {
+        return 0;
+    }
+    return mix((static_cast<uint64_t>(territory->id) << 32) ^ static_cast<uint32_t>(armies));
+}
+
+// computes the hashes from scratch, after the territories were changed without notifying the map
+void Map::computeHashes() {
+    ownershipHash = 0;
+    armiesHash = 0;
+    ownerKeys.assign(numTerritories, 0);
+    for (int i = 0; i < numTerritories; i++) {
+        if (territories[i] != nullptr) {
+            ownerKeys[i] = ownerKey(territories[i], territories[i]->owner);
+            ownershipHash ^= ownerKeys[i];
+            armiesHash ^= armiesKey(territories[i], territories[i]->numArmies);
+        }
+    }
+}
+
+// the owners of the territories are changed first, so that each player list and each continent is then updated once
+void Map::transferTerritories(const vector<Territory*> &transferred, Player *newOwner, bool quiet) {
+    vector<Territory*> moved;
+    vector<pair<Player*, vector<Territory*>>> losses; //territories lost by each previous owner
+    vector<Continent*> continentsChanged;
+    for (auto &territory : transferred) {
+        if (territory == nullptr || territory->map != this || territory->owner == newOwner) {
+            continue;
+        }
+        Player* oldOwner = territory->owner;
+        territory->owner = newOwner;
+        moved.push_back(territory);
+        territoryOwnerChanged(territory, oldOwner);
+        if (oldOwner != nullptr) {
+            auto loss = find_if(losses.begin(), losses.end(), [oldOwner](const pair<Player*, vector<Territory*>> &entry) {
+                return entry.first == oldOwner;
+            });
+            if (loss == losses.end()) {
+                losses.push_back({oldOwner, {}});
+                loss = losses.end() - 1;
+            }
+            loss->second.push_back(territory);
+        }
+        if (territory->continent != nullptr &&
+            find(continentsChanged.begin(), continentsChanged.end(), territory->continent) == continentsChanged.end()) {
+            continentsChanged.push_back(territory->continent);
+        }
+    }
+    if (moved.empty()) {
+        return;
+    }
+
+    for (auto &loss : losses) {
+        loss.first->removeTerritories(loss.second);
+    }
+    if (newOwner != nullptr) {
+        newOwner->appendTerritories(moved);
+    }
+
+    // a continent belongs to the player holding all of its territories
+    for (auto &continent : continentsChanged) {
+        Player* owner = nullptr;
+        bool first = true;
+        for (int i = 0; i < continent->numTerritories; i++) {
+            Territory* territory = continent->territories != nullptr ? continent->territories[i] : nullptr;
+            if (territory == nullptr) {
+                continue;
+            }
+            if (first || territory->owner == owner) {
+                owner = territory->owner;
+                first = false;
+            } else {
+                owner = nullptr;
+                break;
+            }
+        }
+        continent->owner = owner;
+    }
+
+    if (quiet) {
+        return;
+    }
+    Stats::increment(StatCounter::TERRITORIES_TRANSFERRED, static_cast<long>(moved.size()));
+    if (transferListener != nullptr) {
+        transferListener->territoriesTransferred(moved, newOwner);
+    }
+}
+
+// mutator for the listener told about bulk transfers
+void Map::setTransferListener(TransferListener *listener) {
+    transferListener = listener;
+}
+
+// accessor to the number of changes of the board so far
+uint64_t Map::getEpoch() const {
+    return epoch;
+}
+
+// called by a territory of this map after its number of armies changed
+void Map::territoryArmiesChanged(Territory *territory, int oldArmies) {
+    epoch++;
+    armiesHash ^= armiesKey(territory, oldArmies) ^ armiesKey(territory, territory->numArmies);
+    if (threatMap != nullptr) {
+        threatMap->armiesChanged(territory, territory->numArmies - oldArmies);
+    }
+    if (boardStats != nullptr) {
+        boardStats->armiesChanged(territory);
+    }
+}
+
+// called by a territory of this map after its owner changed
+void Map::territoryOwnerChanged(Territory *territory, Player *oldOwner) {
+    epoch++;
+    uint64_t &key = ownerKeys[territory->id - 1];
+    ownershipHash ^= key;
+    key = ownerKey(territory, territory->owner);
+    ownershipHash ^= key;
+    if (threatMap != nullptr) {
+        threatMap->ownerChanged(territory, oldOwner);
+    }
+    if (boardStats != nullptr) {
+        boardStats->ownerChanged(territory);
+    }
+}
+
+// called by a territory of this map after the armies about to arrive or leave it changed
+void Map::territoryPendingArmiesChanged(Territory *territory) {
+    epoch++;
+}
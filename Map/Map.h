@@ -8,6 +8,9 @@
 #include <string>
 #include "../Player/Player.h"
 #include "../GameEngine/GameEngine.h"
+#include "../Map/MapTopology.h"
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <regex>
 #include <fstream>
@@ -23,6 +26,17 @@ class Territory;
 class Continent;
 class Player;
 class GameEngine;
+class ThreatMap;
+class BoardStats;
+
+/**
+ * Told by a map about the territories it hands over in bulk, see Map::transferTerritories
+ */
+class TransferListener {
+public:
+    virtual ~TransferListener() = default;
+    virtual void territoriesTransferred(const vector<Territory*> &territories, Player *newOwner) = 0;
+};
 
 class MapLoader{
 public:
@@ -38,9 +52,14 @@ private:
     friend ostream& operator << (ostream &stream, const MapLoader &mapLoader);
 };
 
+/**
+ * The board of one game. The names, continents and borders come from a MapTopology shared with every other map
+ * loaded from the same file, the map only owns the territories and continents holding the owners and armies of its game.
+ */
 class Map{
 public:
     Map();
+    explicit Map(shared_ptr<const MapTopology> topology);
     Map(Map const &anotherMap);
     Map& operator = (Map const &anotherMap);
     ~Map();
@@ -55,12 +74,63 @@ public:
 
     int getNumTerritories();
     Territory **getTerritories() const;
+
+    // the read only part of this map, nullptr for an empty map
+    const MapTopology* getTopology() const;
+
+    // the territory with that name, nullptr if there is none
+    Territory* findTerritory(const string &name) const;
+
+    // Zobrist hashes of the board, kept up to date by the territories of this map in O(1) per change:
+    // boards with the same owners and armies have the same board hash, boards with the same owners the same ownership hash
+    uint64_t getBoardHash() const;
+    uint64_t getOwnershipHash() const;
+
+    // hands territories of this map over to a player in a single pass: the territory lists of the players, the owners
+    // of the continents, the threat map and the hashes are updated once for the whole set
+    // the territories already owned by the player are left as they are
+    // a quiet transfer, made by an order applied to be taken back, is neither counted nor told to the listener
+    void transferTerritories(const vector<Territory*> &territories, Player *newOwner, bool quiet = false);
+
+    // told about the territories handed over by transferTerritories, nullptr for nobody
+    void setTransferListener(TransferListener *listener);
+
+    // per-territory enemy pressure, built on first use then kept up to date by the territories of this map
+    ThreatMap* getThreatMap();
+
+    // per-player territory counts, army totals, strongest territory and continent control, built on first use then
+    // kept up to date by the territories of this map and swept again once per change of the board
+    BoardStats* getBoardStats();
+
+    // number of changes of the owners, armies and pending armies of the territories of this map so far,
+    // results computed from the board stay valid as long as it does not change
+    uint64_t getEpoch() const;
+
+    // notifications sent by the territories of this map whenever their armies or owner change
+    void territoryArmiesChanged(Territory *territory, int oldArmies);
+    void territoryOwnerChanged(Territory *territory, Player *oldOwner);
+    void territoryPendingArmiesChanged(Territory *territory);
 private:
+    shared_ptr<const MapTopology> topology;
     Territory** territories;
     Continent** continents;
+    Territory** adjTerritories; //the adjacent territories of all the territories, one block per map
+    Territory** continentTerritories; //the territories of all the continents, one block per map
     int numContinents, numTerritories;
+    ThreatMap* threatMap;
+    BoardStats* boardStats;
+    uint64_t epoch;
+    TransferListener* transferListener;
+    uint64_t ownershipHash;
+    uint64_t armiesHash;
+    vector<uint64_t> ownerKeys; //key of the current owner of each territory, old owners may already be deleted
+    static uint64_t ownerKey(const Territory *territory, const Player *owner);
+    static uint64_t armiesKey(const Territory *territory, int armies);
+    void computeHashes();
+    void build();
+    void release();
+    void linkTerritoriesToMap();
     bool checkConnectivity(Territory *ter, Territory **path, bool withinContinent) const;
-    friend Map* MapLoader::loadMapFile(string fileName);
     friend ostream& operator << (ostream &stream, const Map &map);
 };
 
@@ -78,7 +148,7 @@ public:
     void setOwner(Player *owner);
     Player* getOwner() const;
     int getId() const;
-    string getName() const;
+    const string &getName() const;
     void setNumberOfArmies(int newArmies);
     void removeOwner();
     int getNumberOfArmies() const;
@@ -97,21 +167,25 @@ public:
     int getNumAdjTerritories() const;
     Territory ** getAdjTerritories() const;
     ///////////////////////////////////////////////
+
+    // the map this territory belongs to, nullptr for a territory created on its own
+    Map* getMap() const;
 private:
     Territory** adjTerritories;
     Continent* continent;
     Player* owner;
+    Map* map;
     int numArmies;
     int id;
     int numAdjTerritories;
-    string name;
+    const string *name; //interned in the NameTable
     friend Continent;
     friend MapLoader;
     friend Map;
     friend ostream& operator << (ostream &stream, const Territory &territory);
     int pendingIncomingArmies;
     int pendingOutgoingArmies;
-
+    Territory(int id, const string *name, Continent *continent);
 };
 
 class Continent{
@@ -120,7 +194,7 @@ public:
     Continent(int id, string name, int bonus);
     Continent(Continent const &anotherContinent);
     Continent& operator = (Continent const &anotherContinent);
-    string getName() const;
+    const string &getName() const;
     ~Continent();
     Player* getOwner() const;
     ////////////////////////////////////////////////////////// SARAH
@@ -128,11 +202,12 @@ public:
     /////////////////////////////////////////////////////////////////
 private:
     int id;
-    string name;
+    const string *name; //interned in the NameTable
     int bonus;
     Territory** territories;
     int numTerritories;
     Player* owner;
+    Continent(int id, const string *name, int bonus);
     void setTerritories(int numTerritories, Territory** territories);
     friend MapLoader;
     friend Map;
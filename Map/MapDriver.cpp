@@ -3,8 +3,130 @@
 //
 
 #include "MapDriver.h"
+#include "ThreatMap.h"
 class player;
 
+namespace {
+    // sum of the enemy armies adjacent to a territory, the way the threat map should have kept it
+    int threatOf(Territory *territory) {
+        int threat = 0;
+        for (int i = 0; i < territory->getNumAdjTerritories(); i++) {
+            Territory *neighbour = territory->getAdjTerritories()[i];
+            if (neighbour->getOwner() != territory->getOwner()) {
+                threat += neighbour->getNumberOfArmies();
+            }
+        }
+        return threat;
+    }
+
+    // the most threatened territories of a player follow the armies put next to them
+    void threatMapDriver() {
+        cout << "\n\n\n\nThreat map of Canada, the territories being dealt in turn to two players" << endl;
+        Map* map = MapLoader::loadMapFile("../Map/maps/canada.map");
+        Player* player = new Player("Fadi");
+        Player* enemy = new Player("Enemy");
+        for (int i = 0; i < map->getNumTerritories(); i++) {
+            (i % 2 == 0 ? player : enemy)->addTerritory(map->getTerritories()[i]);
+            map->getTerritories()[i]->setNumberOfArmies(1);
+        }
+        ThreatMap* threatMap = map->getThreatMap();
+
+        // armies massed on an enemy territory bordering the player make its neighbours the most threatened ones
+        Territory* massed = nullptr;
+        for (auto &territory : enemy->getTerritories()) {
+            if (massed == nullptr && threatOf(territory) > 0) {
+                massed = territory;
+            }
+        }
+        massed->addArmies(20);
+        cout << "20 armies are added to " << massed->getName() << endl;
+
+        vector<Territory*> threatened = threatMap->mostThreatened(player, 5);
+        bool ordered = true;
+        for (size_t i = 0; i < threatened.size(); i++) {
+            Territory* territory = threatened[i];
+            cout << "[" << i + 1 << "] " << territory->getName() << ": threat " << threatMap->getThreat(territory) << endl;
+            ordered = ordered && threatMap->getThreat(territory) == threatOf(territory) &&
+                      (i == 0 || threatMap->getThreat(threatened[i - 1]) >= threatMap->getThreat(territory));
+        }
+        bool bordersMassed = false;
+        for (int i = 0; !threatened.empty() && i < threatened.front()->getNumAdjTerritories(); i++) {
+            bordersMassed = bordersMassed || threatened.front()->getAdjTerritories()[i] == massed;
+        }
+        cout << (ordered ? "The territories are ordered by their threat" : "The territories are NOT ordered by their threat") << endl;
+        cout << (bordersMassed ? "The most threatened territory borders " : "The most threatened territory does NOT border ")
+             << massed->getName() << endl;
+
+        // once the armies are gone, the threat goes down with them
+        Territory* mostThreatened = threatened.front();
+        massed->setNumberOfArmies(1);
+        cout << "The armies of " << massed->getName() << " are removed: " << mostThreatened->getName() << " now has threat "
+             << threatMap->getThreat(mostThreatened) << (threatMap->getThreat(mostThreatened) == threatOf(mostThreatened) ? "" : " (NOT up to date)") << endl;
+
+        delete player;
+        delete enemy;
+        delete map;
+    }
+
+    // whether the territory list of a player holds exactly the territories of the map it owns
+    bool listMatchesOwners(Map *map, Player *player) {
+        int owned = 0;
+        for (int i = 0; i < map->getNumTerritories(); i++) {
+            owned += map->getTerritories()[i]->getOwner() == player ? 1 : 0;
+        }
+        for (auto &territory : player->getTerritories()) {
+            if (territory->getOwner() != player) {
+                return false;
+            }
+        }
+        return static_cast<int>(player->getTerritories().size()) == owned;
+    }
+
+    // a batch transfer updates the territory lists of the players and the owners of the continents it touches
+    void transferDriver() {
+        cout << "\n\n\n\nBatch transfer on Canada, the territories being dealt in turn to two players" << endl;
+        Map* map = MapLoader::loadMapFile("../Map/maps/canada.map");
+        Player* player = new Player("Fadi");
+        Player* enemy = new Player("Enemy");
+        for (int i = 0; i < map->getNumTerritories(); i++) {
+            (i % 2 == 0 ? player : enemy)->addTerritory(map->getTerritories()[i]);
+        }
+
+        // the whole continent of the first territory, including the territories the player already owns,
+        // and one enemy territory of another continent
+        Continent* taken = map->getTerritories()[0]->getContinent();
+        vector<Territory*> batch;
+        Territory* outside = nullptr;
+        for (int i = 0; i < map->getNumTerritories(); i++) {
+            Territory* territory = map->getTerritories()[i];
+            if (territory->getContinent() == taken) {
+                batch.push_back(territory);
+            } else if (outside == nullptr && territory->getOwner() == enemy) {
+                outside = territory;
+            }
+        }
+        batch.push_back(outside);
+        size_t playerBefore = player->getTerritories().size();
+        size_t enemyBefore = enemy->getTerritories().size();
+        map->transferTerritories(batch, player);
+
+        cout << batch.size() << " territories of " << taken->getName() << " and " << outside->getContinent()->getName()
+             << " are handed over to " << player->getName() << endl;
+        cout << player->getName() << " goes from " << playerBefore << " to " << player->getTerritories().size()
+             << " territories, " << enemy->getName() << " from " << enemyBefore << " to " << enemy->getTerritories().size() << endl;
+        bool listsMatch = listMatchesOwners(map, player) && listMatchesOwners(map, enemy) &&
+                          player->getTerritories().size() + enemy->getTerritories().size() == static_cast<size_t>(map->getNumTerritories());
+        cout << (listsMatch ? "The territory lists match the owners of the territories" : "The territory lists do NOT match the owners of the territories") << endl;
+        cout << taken->getName() << " is owned by " << (taken->getOwner() != nullptr ? taken->getOwner()->getName() : "nobody") << endl;
+        cout << outside->getContinent()->getName() << " is owned by "
+             << (outside->getContinent()->getOwner() != nullptr ? outside->getContinent()->getOwner()->getName() : "nobody") << endl;
+
+        delete player;
+        delete enemy;
+        delete map;
+    }
+}
+
 void mapDriver() {
     // default constructor
     Map* map0 = new Map();
@@ -156,4 +278,7 @@ void mapDriver() {
     }
     delete map5;
     map5 = nullptr;
+
+    threatMapDriver();
+    transferDriver();
 }
\ No newline at end of file
@@ -0,0 +1,219 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "MapTopology.h"
+#include "NameTable.h"
+#include <fstream>
+#include <mutex>
+#include <regex>
+#include <sstream>
+#include <unordered_map>
+
+namespace {
+    // topologies of the map files loaded so far, kept only while a map still uses them
+    mutex cacheMutex;
+    unordered_map<string, weak_ptr<const MapTopology>> cache;
+}
+
+MapTopology::MapTopology() : numContinentTerritories(0) {}
+
+shared_ptr<const MapTopology> MapTopology::load(const string &fileName) {
+    lock_guard<mutex> lock(cacheMutex);
+    shared_ptr<const MapTopology> topology = cache[fileName].lock();
+    if (topology != nullptr) {
+        return topology;
+    }
+    ifstream mapFile(fileName);
+    topology = parse(mapFile);
+    // a file that could not be read is not remembered, it may be there the next time
+    if (mapFile.is_open()) {
+        cache[fileName] = topology;
+    } else {
+        cache.erase(fileName);
+    }
+    return topology;
+}
+
+// a section of the file lasts until the next blank line
+// territories have to be listed in order of id, a territory belongs to the continent of its line,
+// and a borders line lists the ids of the territories adjacent to its first id
+shared_ptr<const MapTopology> MapTopology::parse(istream &mapFile) {
+    shared_ptr<MapTopology> topology(new MapTopology());
+    regex regexSection("(\\[)(.+)(\\])");
+    smatch strMatch;
+    string line;
+    string section;
+    vector<string> continentLines, countryLines, borderLines;
+    while (!mapFile.eof() && !mapFile.fail()) {
+        getline(mapFile, line);
+        bool regexFlag = regex_match(line, strMatch, regexSection);
+        if (regexFlag) {
+            section = strMatch[2].str();
+        }
+        if (line.length() == 0) {
+            section = "";
+        }
+        if (!regexFlag && line.length() > 0) {
+            if (section == "continents") {
+                continentLines.push_back(line);
+            } else if (section == "countries") {
+                countryLines.push_back(line);
+            } else if (section == "borders") {
+                borderLines.push_back(line);
+            }
+        }
+    }
+
+    int numContinents = static_cast<int>(continentLines.size());
+    for (auto &continentLine : continentLines) {
+        istringstream strStream(continentLine);
+        ContinentInfo continent = {nullptr, 0, false, {}};
+        string name, color;
+        continent.valid = static_cast<bool>(strStream >> name >> continent.bonus >> color);
+        continent.name = NameTable::intern(name);
+        topology->continents.push_back(continent);
+    }
+
+    // a continent gets as many territories as in the last run of consecutive lines of its territories
+    vector<int> numCntryInContnt(numContinents, 0);
+    int prevContntId = 1;
+    int cntryInContnt = 0;
+    int numTerritories = static_cast<int>(countryLines.size());
+    for (int i = 0; i < numTerritories; i++) {
+        istringstream strStream(countryLines[i]);
+        int id = 0, continentId = 0, x, y;
+        string name;
+        TerritoryInfo territory = {nullptr, -1, false, -1, 0};
+        if (strStream >> id >> name >> continentId >> x >> y && id == i + 1) {
+            territory.valid = true;
+            topology->territoryIndexes.emplace(NameTable::intern(name), i);
+            if (continentId > 0 && continentId <= numContinents && topology->continents[continentId - 1].valid) {
+                territory.continent = continentId - 1;
+            }
+        }
+        territory.name = NameTable::intern(name);
+        topology->territories.push_back(territory);
+
+        if (prevContntId == continentId) {
+            cntryInContnt++;
+        } else {
+            if (prevContntId > 0 && prevContntId <= numContinents) {
+                numCntryInContnt[prevContntId - 1] = cntryInContnt;
+                cntryInContnt = 1;
+            }
+            prevContntId = continentId;
+        }
+        if (i == numTerritories - 1 && continentId > 0 && continentId <= numContinents) {
+            numCntryInContnt[continentId - 1] = cntryInContnt;
+        }
+    }
+    for (int j = 0; j < numContinents; j++) {
+        ContinentInfo &continent = topology->continents[j];
+        if (!continent.valid) {
+            continue;
+        }
+        for (int k = 0; k < numTerritories && static_cast<int>(continent.territories.size()) < numCntryInContnt[j]; k++) {
+            if (topology->territories[k].continent == j) {
+                continent.territories.push_back(k);
+            }
+        }
+        // the territories missing from the continent are left out of it
+        continent.territories.resize(numCntryInContnt[j], -1);
+        topology->numContinentTerritories += numCntryInContnt[j];
+    }
+
+    // the number of borders of a territory counts every id of its lines, but only the last line lists them
+    vector<int> numBorders(numTerritories, 0);
+    vector<vector<int>> borders(numTerritories);
+    vector<bool> hasBorders(numTerritories, false);
+    for (auto &borderLine : borderLines) {
+        istringstream strStream(borderLine);
+        int terId = -1, adjTerId;
+        strStream >> terId;
+        if (terId <= 0 || terId > numTerritories) {
+            continue;
+        }
+        hasBorders[terId - 1] = true;
+        borders[terId - 1].clear();
+        while (strStream >> adjTerId) {
+            numBorders[terId - 1]++;
+            if (adjTerId > 0) {
+                borders[terId - 1].push_back(adjTerId <= numTerritories ? adjTerId - 1 : -1);
+            }
+        }
+    }
+    for (int i = 0; i < numTerritories; i++) {
+        if (hasBorders[i]) {
+            TerritoryInfo &territory = topology->territories[i];
+            territory.firstAdjTerritory = static_cast<int>(topology->adjTerritories.size());
+            territory.numAdjTerritories = numBorders[i];
+            topology->adjTerritories.insert(topology->adjTerritories.end(), borders[i].begin(), borders[i].end());
+            topology->adjTerritories.resize(territory.firstAdjTerritory + numBorders[i], -1);
+        }
+    }
+    return topology;
+}
+
+int MapTopology::getNumTerritories() const {
+    return static_cast<int>(territories.size());
+}
+
+int MapTopology::getNumContinents() const {
+    return static_cast<int>(continents.size());
+}
+
+bool MapTopology::isTerritoryValid(int territory) const {
+    return territories[territory].valid;
+}
+
+const string &MapTopology::getTerritoryName(int territory) const {
+    return *territories[territory].name;
+}
+
+int MapTopology::getTerritoryContinent(int territory) const {
+    return territories[territory].continent;
+}
+
+// a name that was never interned is the name of no territory
+int MapTopology::findTerritory(const string &name) const {
+    const string *interned = NameTable::find(name);
+    auto found = interned != nullptr ? territoryIndexes.find(interned) : territoryIndexes.end();
+    return found != territoryIndexes.end() ? found->second : -1;
+}
+
+bool MapTopology::hasBorders(int territory) const {
+    return territories[territory].firstAdjTerritory >= 0;
+}
+
+int MapTopology::getNumAdjTerritories(int territory) const {
+    return territories[territory].numAdjTerritories;
+}
+
+const int *MapTopology::getAdjTerritories(int territory) const {
+    return hasBorders(territory) ? adjTerritories.data() + territories[territory].firstAdjTerritory : nullptr;
+}
+
+bool MapTopology::isContinentValid(int continent) const {
+    return continents[continent].valid;
+}
+
+const string &MapTopology::getContinentName(int continent) const {
+    return *continents[continent].name;
+}
+
+int MapTopology::getContinentBonus(int continent) const {
+    return continents[continent].bonus;
+}
+
+const vector<int> &MapTopology::getContinentTerritories(int continent) const {
+    return continents[continent].territories;
+}
+
+int MapTopology::getNumBorders() const {
+    return static_cast<int>(adjTerritories.size());
+}
+
+int MapTopology::getNumContinentTerritories() const {
+    return numContinentTerritories;
+}
@@ -0,0 +1,108 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#ifndef COMP345_N11_MAPTOPOLOGY_H
+#define COMP345_N11_MAPTOPOLOGY_H
+
+#include <istream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+/**
+ * The part of a map that never changes during a game: territory and continent names, continent bonuses,
+ * which territories form each continent and the borders between territories.
+ * A topology is parsed once per map file and shared, read only, by every Map loaded from that file; each Map only
+ * adds the board of its own game (owners, armies and pending armies) on top of it.
+ * Territories and continents are referred to by their index in the file, from 0, and -1 stands for none.
+ * Names are interned in the NameTable.
+ */
+class MapTopology {
+public:
+    MapTopology(const MapTopology &anotherTopology) = delete;
+    MapTopology& operator = (const MapTopology &anotherTopology) = delete;
+
+    /**
+     * parses a map file, or returns the topology already parsed from it while any map of that file is still alive
+     * safe to call from several threads at once
+     * @param fileName path of the map file
+     * @return the topology, empty if the file cannot be read
+     */
+    static shared_ptr<const MapTopology> load(const string &fileName);
+
+    /**
+     * parses a map file without sharing the result
+     */
+    static shared_ptr<const MapTopology> parse(istream &mapFile);
+
+    int getNumTerritories() const;
+    int getNumContinents() const;
+
+    /**
+     * @return false if the line of the territory is malformed or out of order, the territory is then left out of the map
+     */
+    bool isTerritoryValid(int territory) const;
+    const string &getTerritoryName(int territory) const;
+    int getTerritoryContinent(int territory) const;
+
+    /**
+     * finds a valid territory by name in O(1)
+     * @return the index of the first valid territory with that name, -1 if there is none
+     */
+    int findTerritory(const string &name) const;
+
+    /**
+     * @return false if the territory has no line in the borders section
+     */
+    bool hasBorders(int territory) const;
+    int getNumAdjTerritories(int territory) const;
+
+    /**
+     * @return the indexes of the adjacent territories, -1 for the ids of the borders line that are not territories
+     */
+    const int *getAdjTerritories(int territory) const;
+
+    bool isContinentValid(int continent) const;
+    const string &getContinentName(int continent) const;
+    int getContinentBonus(int continent) const;
+    const vector<int> &getContinentTerritories(int continent) const;
+
+    /**
+     * @return total number of borders, over all the territories
+     */
+    int getNumBorders() const;
+
+    /**
+     * @return total number of territories listed by the continents
+     */
+    int getNumContinentTerritories() const;
+
+private:
+    struct TerritoryInfo {
+        const string *name;
+        int continent;
+        bool valid;
+        int firstAdjTerritory; //index in adjTerritories, -1 without a borders line
+        int numAdjTerritories;
+    };
+
+    struct ContinentInfo {
+        const string *name;
+        int bonus;
+        bool valid;
+        vector<int> territories;
+    };
+
+    vector<TerritoryInfo> territories;
+    vector<ContinentInfo> continents;
+    vector<int> adjTerritories; //the borders of all the territories, one after the other
+    unordered_map<const string*, int> territoryIndexes; //by interned name
+    int numContinentTerritories;
+
+    MapTopology();
+};
+
+#endif //COMP345_N11_MAPTOPOLOGY_H
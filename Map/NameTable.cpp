@@ -0,0 +1,27 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "NameTable.h"
+#include <mutex>
+#include <unordered_set>
+
+namespace {
+    // elements of an unordered_set keep their address when it grows
+    mutex namesMutex;
+    unordered_set<string> &names() {
+        static unordered_set<string> table;
+        return table;
+    }
+}
+
+const string *NameTable::intern(const string &name) {
+    lock_guard<mutex> lock(namesMutex);
+    return &*names().insert(name).first;
+}
+
+const string *NameTable::find(const string &name) {
+    lock_guard<mutex> lock(namesMutex);
+    auto found = names().find(name);
+    return found != names().end() ? &*found : nullptr;
+}
@@ -0,0 +1,33 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#ifndef COMP345_N11_NAMETABLE_H
+#define COMP345_N11_NAMETABLE_H
+
+#include <string>
+using namespace std;
+
+/**
+ * Process wide table of the names of territories and continents.
+ * Each distinct name is stored once and never moves nor goes away, so territories and continents keep a pointer to
+ * their name instead of a copy, every game on a map uses the same names, and two interned names are equal exactly
+ * when they are the same pointer.
+ */
+class NameTable {
+public:
+    NameTable() = delete;
+
+    /**
+     * safe to call from several threads at once
+     * @return the single stored copy of the name, added if it was not there yet
+     */
+    static const string *intern(const string &name);
+
+    /**
+     * @return the stored copy of the name, nullptr if no territory or continent was ever given that name
+     */
+    static const string *find(const string &name);
+};
+
+#endif //COMP345_N11_NAMETABLE_H
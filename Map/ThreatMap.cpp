@@ -0,0 +1,183 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "ThreatMap.h"
+#include "Map.h"
+#include <algorithm>
+
+// builds the threat scores of all territories of the map and the heaps of the players currently owning them
+ThreatMap::ThreatMap(Map *map) : map(map) {
+    numTerritories = map->getNumTerritories();
+    Territory** territories = map->getTerritories();
+    threats.assign(numTerritories, 0);
+    versions.assign(numTerritories, 0);
+    dependents.resize(numTerritories);
+
+    for (int i = 0; i < numTerritories; i++) {
+        Territory* territory = territories != nullptr ? territories[i] : nullptr;
+        if (territory == nullptr) {
+            continue;
+        }
+        for (int j = 0; j < territory->getNumAdjTerritories(); j++) {
+            Territory* adjTerritory = territory->getAdjTerritories()[j];
+            int adjIndex = indexOf(adjTerritory);
+            if (adjIndex < 0) {
+                continue;
+            }
+            dependents[adjIndex].push_back(territory);
+            if (adjTerritory->getOwner() != territory->getOwner()) {
+                threats[i] += adjTerritory->getNumberOfArmies();
+            }
+        }
+    }
+
+    for (int i = 0; i < numTerritories; i++) {
+        if (territories != nullptr && territories[i] != nullptr && territories[i]->getOwner() != nullptr) {
+            touch(territories[i]);
+        }
+    }
+}
+
+ThreatMap::~ThreatMap() {
+    heaps.clear();
+}
+
+// heap ordering: the higher threat wins, then the territory with fewer armies to defend it, then the lowest id
+// the order is total, so the result only depends on the board and not on the history of the heap
+bool ThreatMap::lessThreatened(const Entry &a, const Entry &b) {
+    if (a.threat != b.threat) {
+        return a.threat < b.threat;
+    }
+    if (a.armies != b.armies) {
+        return a.armies > b.armies;
+    }
+    return a.territory->getId() > b.territory->getId();
+}
+
+// position of a territory in the map's list of territories, -1 if the territory is not part of this map
+int ThreatMap::indexOf(const Territory *territory) const {
+    if (territory == nullptr) {
+        return -1;
+    }
+    int index = territory->getId() - 1;
+    if (index < 0 || index >= numTerritories || map->getTerritories()[index] != territory) {
+        return -1;
+    }
+    return index;
+}
+
+int ThreatMap::getThreat(const Territory *territory) const {
+    int index = indexOf(territory);
+    return index < 0 ? 0 : threats[index];
+}
+
+// invalidates the heap entries of a territory and pushes a fresh one in the heap of its owner
+void ThreatMap::touch(Territory *territory) {
+    int index = indexOf(territory);
+    if (index < 0) {
+        return;
+    }
+    versions[index]++;
+    Player* owner = territory->getOwner();
+    if (owner == nullptr) {
+        return;
+    }
+    vector<Entry> &heap = heaps[owner];
+    heap.push_back({threats[index], territory->getNumberOfArmies(), versions[index], territory});
+    push_heap(heap.begin(), heap.end(), lessThreatened);
+
+    // stale entries are normally dropped when they reach the top, this keeps heaps bounded when they never do
+    if (heap.size() > 2 * static_cast<size_t>(numTerritories) + 16) {
+        compact(heap, owner);
+    }
+}
+
+// an entry is fresh if nothing changed on its territory since it was pushed
+bool ThreatMap::isFresh(const Entry &entry, Player *player) const {
+    int index = indexOf(entry.territory);
+    return index >= 0 && versions[index] == entry.version && entry.territory->getOwner() == player;
+}
+
+// removes every stale entry of a heap
+void ThreatMap::compact(vector<Entry> &heap, Player *player) {
+    heap.erase(remove_if(heap.begin(), heap.end(), [this, player](const Entry &entry) {
+        return !isFresh(entry, player);
+    }), heap.end());
+    make_heap(heap.begin(), heap.end(), lessThreatened);
+}
+
+Territory *ThreatMap::mostThreatened(Player *player) {
+    vector<Territory*> top = mostThreatened(player, 1);
+    return top.empty() ? nullptr : top.front();
+}
+
+vector<Territory *> ThreatMap::mostThreatened(Player *player, int count) {
+    vector<Territory*> result;
+    auto found = heaps.find(player);
+    if (found == heaps.end() || count <= 0) {
+        return result;
+    }
+    vector<Entry> &heap = found->second;
+    vector<Entry> taken;
+    while (!heap.empty() && static_cast<int>(taken.size()) < count) {
+        pop_heap(heap.begin(), heap.end(), lessThreatened);
+        Entry entry = heap.back();
+        heap.pop_back();
+        if (isFresh(entry, player)) {
+            taken.push_back(entry);
+            result.push_back(entry.territory);
+        }
+    }
+
+    // the returned territories stay in the heap
+    for (auto &entry : taken) {
+        heap.push_back(entry);
+        push_heap(heap.begin(), heap.end(), lessThreatened);
+    }
+    return result;
+}
+
+// a territory gained or lost armies: every adjacent territory owned by someone else sees its threat change
+void ThreatMap::armiesChanged(Territory *territory, int delta) {
+    int index = indexOf(territory);
+    if (index < 0) {
+        return;
+    }
+    for (auto &dependent : dependents[index]) {
+        if (dependent->getOwner() != territory->getOwner()) {
+            threats[dependent->getId() - 1] += delta;
+            touch(dependent);
+        }
+    }
+    // the number of armies is the tie breaker of the heaps
+    touch(territory);
+}
+
+// a territory changed hands: its armies now threaten a different set of neighbours, and its own threat is recomputed
+void ThreatMap::ownerChanged(Territory *territory, Player *oldOwner) {
+    int index = indexOf(territory);
+    if (index < 0) {
+        return;
+    }
+    Player* newOwner = territory->getOwner();
+    int armies = territory->getNumberOfArmies();
+    for (auto &dependent : dependents[index]) {
+        bool wasEnemy = dependent->getOwner() != oldOwner;
+        bool isEnemy = dependent->getOwner() != newOwner;
+        if (wasEnemy != isEnemy) {
+            threats[dependent->getId() - 1] += isEnemy ? armies : -armies;
+            touch(dependent);
+        }
+    }
+
+    int threat = 0;
+    for (int i = 0; i < territory->getNumAdjTerritories(); i++) {
+        Territory* adjTerritory = territory->getAdjTerritories()[i];
+        if (indexOf(adjTerritory) >= 0 && adjTerritory->getOwner() != newOwner) {
+            threat += adjTerritory->getNumberOfArmies();
+        }
+    }
+    threats[index] = threat;
+    touch(territory);
+}
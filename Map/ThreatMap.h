@@ -0,0 +1,78 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#ifndef COMP345_N11_THREATMAP_H
+#define COMP345_N11_THREATMAP_H
+
+#include <vector>
+#include <unordered_map>
+using namespace std;
+
+class Map;
+class Territory;
+class Player;
+
+/**
+ * Keeps, for every territory of a map, the sum of the armies standing on adjacent territories owned by another player.
+ * The scores are computed once when the threat map is built, then updated incrementally by the map every time a
+ * territory gains or loses armies or changes owner, so reading them is O(1).
+ * Each player also gets a lazy max-heap of its territories ordered from the most to the least threatened one.
+ */
+class ThreatMap {
+public:
+    explicit ThreatMap(Map *map);
+    ThreatMap(const ThreatMap &anotherThreatMap) = delete;
+    ThreatMap& operator = (const ThreatMap &anotherThreatMap) = delete;
+    ~ThreatMap();
+
+    /**
+     * sum of the enemy armies adjacent to a territory
+     * @param territory a territory of the map
+     * @return the threat score, 0 for a territory that is not part of the map
+     */
+    int getThreat(const Territory *territory) const;
+
+    /**
+     * the territory of a player facing the highest threat, in O(log n)
+     * @param player
+     * @return the most threatened territory, or nullptr if the player owns no territory of the map
+     */
+    Territory* mostThreatened(Player *player);
+
+    /**
+     * the territories of a player facing the highest threats, in O(count * log n)
+     * ties are broken in favour of the territory holding the fewest armies, then of the lowest id
+     * @param player
+     * @param count maximum number of territories to return
+     * @return territories ordered from the most to the least threatened one
+     */
+    vector<Territory*> mostThreatened(Player *player, int count);
+
+    // updates sent by the map
+    void armiesChanged(Territory *territory, int delta);
+    void ownerChanged(Territory *territory, Player *oldOwner);
+
+private:
+    struct Entry {
+        int threat;
+        int armies;
+        unsigned version;
+        Territory* territory;
+    };
+    static bool lessThreatened(const Entry &a, const Entry &b);
+
+    Map* map;
+    int numTerritories;
+    vector<int> threats;
+    vector<unsigned> versions;
+    vector<vector<Territory*>> dependents; // territories having a given territory in their list of adjacent territories
+    unordered_map<Player*, vector<Entry>> heaps;
+
+    int indexOf(const Territory *territory) const;
+    void touch(Territory *territory);
+    bool isFresh(const Entry &entry, Player *player) const;
+    void compact(vector<Entry> &heap, Player *player);
+};
+
+#endif //COMP345_N11_THREATMAP_H
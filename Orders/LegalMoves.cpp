@@ -0,0 +1,107 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "LegalMoves.h"
+
+namespace {
+    // whether the player may attack or move into the territory, see OrderKernel::validateAdvance
+    bool isReachable(Player *player, Territory *territory) {
+        Player *owner = territory->getOwner();
+        return owner == player || owner == nullptr || !player->hasDiplomaticRelation(owner);
+    }
+}
+
+Order* LegalMove::toOrder(Player *issuer, int numberOfArmies) const {
+    switch (type) {
+        case DEPLOY:
+            return new DeployOrder(issuer, numberOfArmies, destination);
+        case ADVANCE:
+            return new AdvanceOrder(issuer, numberOfArmies, source, destination);
+        default:
+            return nullptr;
+    }
+}
+
+LegalMoves::LegalMoves(Player *player, unsigned types) : player(player), types(types), source(nullptr) {
+    reset();
+}
+
+LegalMoves& LegalMoves::from(Territory *source) {
+    this->source = source;
+    return *this;
+}
+
+void LegalMoves::reset() {
+    phase = DEPLOY;
+    index = 0;
+    subIndex = 0;
+}
+
+// enumerates the deploys then the advances, moving on to the advances once the deploys are exhausted
+bool LegalMoves::next(LegalMove &move) {
+    move.source = nullptr;
+    move.destination = nullptr;
+    move.armies = 0;
+    while (phase <= ADVANCE) {
+        OrderType type = static_cast<OrderType>(phase);
+        move.type = type;
+        if (isEnumerated(type) && (type == DEPLOY ? nextDeploy(move) : nextAdvance(move))) {
+            return true;
+        }
+        phase++;
+        index = 0;
+        subIndex = 0;
+    }
+    return false;
+}
+
+vector<LegalMove> LegalMoves::remaining() {
+    vector<LegalMove> moves;
+    LegalMove move;
+    while (next(move)) {
+        moves.push_back(move);
+    }
+    return moves;
+}
+
+bool LegalMoves::isEnumerated(OrderType type) const {
+    if ((types & (1u << type)) == 0) {
+        return false;
+    }
+    return type != DEPLOY || player->getReinforcementPool() > 0;
+}
+
+bool LegalMoves::isSource(Territory *territory) const {
+    return (source == nullptr || territory == source) && territory->getNumberOfMovableArmies() > 0;
+}
+
+// one move per territory of the player, with all its reinforcements
+bool LegalMoves::nextDeploy(LegalMove &move) {
+    if (index >= player->getNumTerritories()) {
+        return false;
+    }
+    move.destination = player->getTerritory(index++);
+    move.armies = player->getReinforcementPool();
+    return true;
+}
+
+// one move per neighbour of each territory with movable armies, index walking the territories and subIndex their borders
+bool LegalMoves::nextAdvance(LegalMove &move) {
+    for (; index < player->getNumTerritories(); index++, subIndex = 0) {
+        Territory *territory = player->getTerritory(index);
+        if (!isSource(territory)) {
+            continue;
+        }
+        while (subIndex < static_cast<size_t>(territory->getNumAdjTerritories())) {
+            Territory *neighbour = territory->getAdjTerritories()[subIndex++];
+            if (isReachable(player, neighbour)) {
+                move.source = territory;
+                move.destination = neighbour;
+                move.armies = territory->getNumberOfMovableArmies();
+                return true;
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,81 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#ifndef COMP345_N11_LEGALMOVES_H
+#define COMP345_N11_LEGALMOVES_H
+
+#include "Orders.h"
+#include <vector>
+using namespace std;
+
+class Player;
+class Territory;
+class Order;
+
+/**
+ * An order a player may issue, as found by LegalMoves.
+ */
+struct LegalMove {
+    OrderType type;
+    Territory* source;      //source of advance moves, nullptr otherwise
+    Territory* destination;
+    int armies;             //most armies the move can deploy or move
+
+    /**
+     * @param numberOfArmies number of armies of the order, between 1 and the armies of the move
+     * @return a new order of the move issued by the player, owned by the caller
+     */
+    Order* toOrder(Player *issuer, int numberOfArmies) const;
+};
+
+/**
+ * Enumerates the deploys and advances a player may issue on the current board, one at a time and only as far as they
+ * are asked for. Deploys go to the territories of the player while it has reinforcements; advances go from the
+ * territories with movable armies to their neighbours, except those of a player with a truce. Moves are found by
+ * walking the territory list of the player in place and their borders once, the owner and the truces being looked up
+ * in O(1).
+ */
+class LegalMoves {
+public:
+    static const unsigned ALL_TYPES = (1u << DEPLOY) | (1u << ADVANCE);
+
+    /**
+     * @param types the kinds of moves to enumerate, a bit 1 << type per kind among ALL_TYPES
+     */
+    explicit LegalMoves(Player *player, unsigned types = ALL_TYPES);
+
+    /**
+     * only enumerates the advance moves leaving from that territory
+     * @return this generator
+     */
+    LegalMoves& from(Territory *source);
+
+    /**
+     * finds the next move
+     * @param move set to the move found
+     * @return false once all the moves have been enumerated
+     */
+    bool next(LegalMove &move);
+
+    // starts the enumeration over, on the board as it is now
+    void reset();
+
+    // enumerates all the remaining moves
+    vector<LegalMove> remaining();
+
+private:
+    Player* player;
+    unsigned types;
+    Territory* source;
+    int phase; //kind of moves being enumerated, as an OrderType
+    size_t index; //territory of the player being enumerated
+    size_t subIndex; //neighbour of that territory being enumerated
+
+    bool isEnumerated(OrderType type) const;
+    bool isSource(Territory *territory) const;
+    bool nextDeploy(LegalMove &move);
+    bool nextAdvance(LegalMove &move);
+};
+
+#endif //COMP345_N11_LEGALMOVES_H
@@ -0,0 +1,378 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "OrderKernel.h"
+#include "Orders.h"
+#include "../GameEngine/GameEngine.h"
+#include "../Stats/Stats.h"
+#include "../Stats/Trace.h"
+#include <algorithm>
+#include <math.h>
+
+namespace {
+/**
+ * This function check if a region is able to be attacked by a specific player
+ * @param attacker
+ * @param target
+ * @return true if the attacker already had the target territory
+ * or check if there is any diplomacy relations between the attacker and the territory target
+ */
+    bool checkIfPossibleToAttack(Player *attacker, Territory *target) {
+        Player *ownerOfTarget = target->getOwner();
+        bool relationsWithHostOfTarget = ownerOfTarget != nullptr && attacker->hasDiplomaticRelation(ownerOfTarget);
+
+        if (relationsWithHostOfTarget) {
+            std::cout << attacker->getName() << " and " << ownerOfTarget->getName()
+                      << " cannot attack each other for the rest of this turn. ";
+        }
+
+        return attacker == ownerOfTarget || !relationsWithHostOfTarget;
+    }
+
+    bool owns(Player *player, Territory *territory) {
+        return territory->getOwner() == player;
+    }
+
+    // where the rules report what they do, nowhere for an order applied quietly
+    struct Report {
+        explicit Report(bool quiet) : nowhere(nullptr), out(quiet ? nowhere : std::cout) {}
+        ostream nowhere;
+        ostream &out;
+    };
+
+    // executes the rule of an order of the given type
+    void run(uint8_t type, Player *issuer, int armies, Territory *source, Territory *destination, Player *target, bool quiet) {
+        switch (type) {
+            case DEPLOY:
+                OrderKernel::deploy(issuer, armies, destination, quiet);
+                break;
+            case ADVANCE:
+                OrderKernel::advance(issuer, armies, source, destination, quiet);
+                break;
+            case BOMB:
+                OrderKernel::bomb(issuer, destination, quiet);
+                break;
+            case BLOCKADE:
+                OrderKernel::blockade(issuer, destination, quiet);
+                break;
+            case AIRLIFT:
+                OrderKernel::airlift(issuer, armies, source, destination, quiet);
+                break;
+            case NEGOTIATE:
+                OrderKernel::negotiate(issuer, target, quiet);
+                break;
+        }
+    }
+
+    // the position is only looked up when the owner of the territory may change
+    TerritoryState save(Territory *territory, bool ownerMayChange) {
+        TerritoryState state = {territory, nullptr, -1, 0, 0, 0};
+        if (territory == nullptr) {
+            return state;
+        }
+        state.owner = territory->getOwner();
+        if (ownerMayChange && state.owner != nullptr) {
+            state.position = state.owner->getTerritoryIndex(territory);
+        }
+        state.armies = territory->getNumberOfArmies();
+        state.pendingIncomingArmies = territory->getPendingIncomingArmies();
+        state.pendingOutgoingArmies = territory->getPendingOutgoingArmies();
+        return state;
+    }
+
+    void restore(const TerritoryState &state) {
+        Territory *territory = state.territory;
+        if (territory == nullptr) {
+            return;
+        }
+        if (territory->getOwner() != state.owner) {
+            if (territory->getOwner() != nullptr) {
+                territory->getOwner()->removeTerritory(territory);
+            }
+            if (state.owner != nullptr) {
+                state.owner->insertTerritory(territory, state.position);
+            }
+        }
+        territory->setNumberOfArmies(state.armies);
+        territory->setPendingIncomingArmies(state.pendingIncomingArmies);
+        territory->setPendingOutgoingArmies(state.pendingOutgoingArmies);
+    }
+}
+
+// If the target territory does not belong to the player that issued the order, the order is invalid.
+bool OrderKernel::validateDeploy(Player *issuer, Territory *destination) {
+    if (issuer == nullptr || destination == nullptr) {
+        return false;
+    }
+    return owns(issuer, destination);
+}
+
+// The selected number of armies is added to the number of armies on the target territory.
+void OrderKernel::deploy(Player *issuer, int armies, Territory *destination, bool quiet) {
+    Report report(quiet);
+    destination->addArmies(armies);
+    destination->setPendingIncomingArmies(0);
+    report.out << "Deployed " << armies << " armies to " << destination->getName() << "." << std::endl;
+}
+
+// If the source territory does not belong to the player that issued the order, the order is invalid.
+// If the target territory is not adjacent to the source territory, the order is invalid.
+bool OrderKernel::validateAdvance(Player *issuer, Territory *source, Territory *destination) {
+    if (issuer == nullptr || source == nullptr || destination == nullptr) {
+        return false;
+    }
+    bool hasAnyArmiesToAdvance = source->getNumberOfArmies() > 0;
+    return owns(issuer, source) && hasAnyArmiesToAdvance && checkIfPossibleToAttack(issuer, destination);
+}
+
+// Moves armies to a territory of the same player, or attacks the territory of another player with them.
+void OrderKernel::advance(Player *issuer, int armies, Territory *source, Territory *destination, bool quiet) {
+    Report report(quiet);
+    Player *defender = destination->getOwner();
+    bool offensive = issuer != defender;
+
+    // Recalculate what number of armies may want to truely be moved if the kingdom of the territory has modified because of an attack
+    int movableArmiesFromSource = armies;
+    if (issuer->getStrategy() != GameEngine::strategyType.at(strategy::Cheater)) {
+        movableArmiesFromSource = std::min(source->getNumberOfArmies(), armies);
+    }
+    if(movableArmiesFromSource>0  && defender->getStrategy() == GameEngine::strategyType.at(strategy::Neutral)){
+        report.out<<"**" << endl;
+        report.out<< "STRATEGY CHANGE: an attack happen to one of the neutral player territories....Now neutral player becomes aggressive player"<<endl;
+        report.out<<"**" << endl;
+        defender->setStrategy(strategy::Aggressive);
+    }
+
+    report.out << "=======An Advanced Order is executed ========";
+    if (offensive) {
+        // Simulate battle
+        source->removeArmies(movableArmiesFromSource);
+
+        //Each attacking army unit involved has 60% chances of killing one defending army.
+        int defendersKilled = round(movableArmiesFromSource * 0.6);
+        //At the same time, each defending army unit has 70% chances of killing one attacking army unit.
+        int attackersKilled = round(destination->getNumberOfArmies() * 0.7);
+
+        int survivingAttackers = std::max(movableArmiesFromSource - attackersKilled, 0);
+        int survivingDefenders = std::max(destination->getNumberOfArmies() - defendersKilled, 0);
+        destination->removeArmies(defendersKilled);
+
+        // Failed attack
+        if (survivingDefenders > 0 || survivingAttackers <= 0) {
+            source->addArmies(survivingAttackers);
+            report.out << "Failed attack on " << destination->getName() << " with " << survivingDefenders
+                       << " enemy armies left standing.";
+
+            if (survivingAttackers > 0) {
+                report.out << " Retreating " << survivingAttackers << " attacking armies back to " << source->getName()
+                           << std::endl;
+            } else {
+                report.out << std::endl;
+            }
+        }
+            // Successful attack: If all the defender's armies are eliminated, the attacker captures the territory
+        else {
+            report.out << "=======Successful Attack: (2) Ownership of a territory is transferred to the attacking player if a territory is conquered. ========" << endl;
+            defender->transferTerritory(destination, issuer, quiet);
+            destination->addArmies(survivingAttackers);
+            report.out << "Attack is successful on the " << destination->getName() << ". " << survivingAttackers
+                       << " armies now attacked and owns this territory." << std::endl;
+        }
+    } else {
+        source->removeArmies(movableArmiesFromSource);
+        destination->addArmies(movableArmiesFromSource);
+        report.out << "Advanced " << movableArmiesFromSource << " armies from " << source->getName() << " to "
+                   << destination->getName() << "." << std::endl;
+    }
+
+    source->setPendingOutgoingArmies(0);
+}
+
+// If the target belongs to the player that issued the order, the order is invalid.
+// If the target territory is not adjacent to one of the territory owned by the player issuing the order, then the order is invalid.
+bool OrderKernel::validateBomb(Player *issuer, Territory *target) {
+    if (issuer == nullptr || target == nullptr) {
+        return false;
+    }
+    return !owns(issuer, target) && checkIfPossibleToAttack(issuer, target);
+}
+
+// Half of the armies are removed from the target territory.
+void OrderKernel::bomb(Player *issuer, Territory *target, bool quiet) {
+    Report report(quiet);
+    int armiesOnTarget = target->getNumberOfArmies();
+    target->removeArmies(armiesOnTarget / 2);
+    report.out << "Bombed " << armiesOnTarget / 2 << " enemy armies on " << target->getName() << ". ";
+    report.out << target->getNumberOfArmies() << " remaining." << std::endl;
+}
+
+// If the target territory belongs to an enemy player, the order is declared invalid.
+bool OrderKernel::validateBlockade(Player *issuer, Territory *territory) {
+    if (issuer == nullptr || territory == nullptr) {
+        return false;
+    }
+    return owns(issuer, territory);
+}
+
+// The number of armies on the territory is doubled and the ownership of the territory is transferred to the Neutral player.
+void OrderKernel::blockade(Player *issuer, Territory *territory, bool quiet) {
+    Report report(quiet);
+    territory->addArmies(territory->getNumberOfArmies());
+    GameEngine::assignToNeutralPlayer(territory, quiet);
+    report.out << "Blockade called on " << territory->getName() << ". ";
+    report.out << territory->getNumberOfArmies() << " neutral armies now occupy this territory." << std::endl;
+}
+
+// If the source or target does not belong to the player that issued the order, the order is invalid.
+bool OrderKernel::validateAirlift(Player *issuer, Territory *source, Territory *destination) {
+    if (issuer == nullptr || source == nullptr || destination == nullptr || source == destination) {
+        return false;
+    }
+    bool hasAnyArmiesToAirlift = source->getNumberOfMovableArmies() > 0;
+    return owns(issuer, source) && owns(issuer, destination) && hasAnyArmiesToAirlift;
+}
+
+// Selected number of armies is moved from the source to the target territory.
+void OrderKernel::airlift(Player *issuer, int armies, Territory *source, Territory *destination, bool quiet) {
+    Report report(quiet);
+    // Recalculate how many armies could actually be moved in case the state of the territory has changed due to an attack
+    int movableArmiesFromSource = std::min(source->getNumberOfArmies(), armies);
+
+    destination->addArmies(movableArmiesFromSource);
+    source->removeArmies(movableArmiesFromSource);
+    source->setPendingOutgoingArmies(0);
+
+    report.out << "Airlifted " << movableArmiesFromSource << " armies from " << source->getName() << " to "
+               << destination->getName() << "." << std::endl;
+}
+
+// If the target is the player issuing the order, then the order is invalid.
+bool OrderKernel::validateNegotiate(Player *issuer, Player *target) {
+    if (issuer == nullptr || target == nullptr) {
+        return false;
+    }
+    return issuer != target;
+}
+
+// Any attack that may be declared between territories of the two players for the rest of the turn will be invalid.
+void OrderKernel::negotiate(Player *issuer, Player *target, bool quiet) {
+    Report report(quiet);
+    issuer->addDiplomaticRelation(target);
+    target->addDiplomaticRelation(issuer);
+    report.out << "Negotiated diplomacy between " << issuer->getName() << " and " << target->getName() << "."
+               << std::endl;
+}
+
+bool OrderKernel::validate(const OrderRecord &record, Map *map, const vector<Player*> &players) {
+    Player *issuer = playerOf(players, record.issuer);
+    switch (record.type) {
+        case DEPLOY:
+            return validateDeploy(issuer, territoryOf(map, record.destination));
+        case ADVANCE:
+            return validateAdvance(issuer, territoryOf(map, record.source), territoryOf(map, record.destination));
+        case BOMB:
+            return validateBomb(issuer, territoryOf(map, record.destination));
+        case BLOCKADE:
+            return validateBlockade(issuer, territoryOf(map, record.destination));
+        case AIRLIFT:
+            return validateAirlift(issuer, territoryOf(map, record.source), territoryOf(map, record.destination));
+        case NEGOTIATE:
+            return validateNegotiate(issuer, playerOf(players, record.target));
+        default:
+            return false;
+    }
+}
+
+// invalid orders are counted, but still executed, as Order::execute does
+bool OrderKernel::execute(const OrderRecord &record, Map *map, const vector<Player*> &players) {
+    if (record.type > NEGOTIATE) {
+        return false;
+    }
+    Player *issuer = playerOf(players, record.issuer);
+    ScopedTimer timer(Stats::order(record.type));
+    TraceSpan span(toString(record.type), "order", Trace::isEnabled() && issuer != nullptr ? "\"issuer\": \"" + Trace::escape(issuer->getName()) + "\"" : "");
+    if (!validate(record, map, players)) {
+        Stats::increment(StatCounter::ORDERS_INVALID);
+    }
+    run(record.type, issuer, record.armies, territoryOf(map, record.source), territoryOf(map, record.destination),
+        playerOf(players, record.target), false);
+    Stats::increment(StatCounter::ORDERS_EXECUTED);
+    return true;
+}
+
+// advances may capture their destination and turn a neutral defender aggressive, blockades hand their territory over
+OrderUndo OrderKernel::capture(uint8_t type, Player *issuer, Territory *source, Territory *destination, Player *target) {
+    OrderUndo undo;
+    undo.type = type;
+    undo.issuer = issuer;
+    undo.target = target;
+    undo.defender = nullptr;
+    undo.defenderStrategy = -1;
+    undo.hadTruce = false;
+    bool captures = type == ADVANCE && destination != nullptr && destination->getOwner() != issuer;
+    undo.source = save(source, false);
+    undo.destination = save(destination, captures || type == BLOCKADE);
+    if (type == ADVANCE && destination != nullptr && destination->getOwner() != nullptr) {
+        undo.defender = destination->getOwner();
+        undo.defenderStrategy = static_cast<int8_t>(GameEngine::getStrategyIndex(undo.defender));
+    }
+    if (type == NEGOTIATE && issuer != nullptr && target != nullptr) {
+        undo.hadTruce = issuer->hasDiplomaticRelation(target);
+    }
+    return undo;
+}
+
+OrderUndo OrderKernel::apply(const OrderRecord &record, Map *map, const vector<Player*> &players) {
+    if (record.type > NEGOTIATE) {
+        OrderUndo none = {};
+        none.type = NEGOTIATE + 1;
+        none.defenderStrategy = -1;
+        return none;
+    }
+    Player *issuer = playerOf(players, record.issuer);
+    Player *target = playerOf(players, record.target);
+    Territory *source = territoryOf(map, record.source);
+    Territory *destination = territoryOf(map, record.destination);
+    OrderUndo undo = capture(record.type, issuer, source, destination, target);
+    run(record.type, issuer, record.armies, source, destination, target, true);
+    return undo;
+}
+
+// the territories, the strategy of the defender and the truce are put back as capture saved them
+void OrderKernel::undo(const OrderUndo &undo) {
+    if (undo.type > NEGOTIATE) {
+        return;
+    }
+    restore(undo.destination);
+    restore(undo.source);
+    if (undo.defender != nullptr && undo.defenderStrategy >= 0 &&
+        GameEngine::getStrategyIndex(undo.defender) != undo.defenderStrategy) {
+        undo.defender->setStrategy(undo.defenderStrategy);
+    }
+    if (undo.type == NEGOTIATE && undo.issuer != nullptr && undo.target != nullptr) {
+        undo.issuer->removeDiplomaticRelation(undo.target, undo.hadTruce);
+        undo.target->removeDiplomaticRelation(undo.issuer, undo.hadTruce);
+    }
+}
+
+uint8_t OrderKernel::indexOf(const vector<Player*> &players, const Player *player) {
+    for (size_t i = 0; i < players.size(); i++) {
+        if (players[i] == player) {
+            return static_cast<uint8_t>(i);
+        }
+    }
+    return NO_PLAYER;
+}
+
+Player *OrderKernel::playerOf(const vector<Player*> &players, uint8_t index) {
+    return index < players.size() ? players[index] : nullptr;
+}
+
+int32_t OrderKernel::idOf(const Territory *territory) {
+    return territory != nullptr ? territory->getId() : 0;
+}
+
+Territory *OrderKernel::territoryOf(Map *map, int32_t id) {
+    return id > 0 && id <= map->getNumTerritories() ? map->getTerritories()[id - 1] : nullptr;
+}
@@ -0,0 +1,122 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#ifndef COMP345_N11_ORDERKERNEL_H
+#define COMP345_N11_ORDERKERNEL_H
+
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+class Map;
+class Player;
+class Territory;
+
+/**
+ * An order as plain data, the way game records store it and GameReplay executes it.
+ * Players are referred to by their index in a list of players and territories by their id, 0 standing for no territory.
+ * Live games do not keep records: the players issue Order objects into their OrdersList, which are encoded to records
+ * only to be recorded, see Order::encode.
+ */
+struct OrderRecord {
+    uint8_t type;     //OrderType, or GameRecordFormat::TRANSFER
+    uint8_t issuer;   //new owner of a transferred territory
+    uint8_t target;   //player targeted by a negotiate order
+    uint8_t unused;
+    int32_t source;
+    int32_t destination; //destination of deploy, advance and airlift orders, target of bomb and blockade orders, transferred territory
+    int32_t armies;
+};
+
+/**
+ * What an order may change on one territory, as it was before the order was applied.
+ */
+struct TerritoryState {
+    Territory* territory; //nullptr for no territory
+    Player* owner;
+    int32_t position; //index of the territory in the list of its owner, -1 when the order cannot change the owner
+    int32_t armies;
+    int32_t pendingIncomingArmies;
+    int32_t pendingOutgoingArmies;
+};
+
+/**
+ * Everything an applied order changed, enough for OrderKernel::undo to put the board and the players back exactly as
+ * they were: the source and destination territories, the strategy of an attacked neutral player and the truce of a
+ * negotiation.
+ */
+struct OrderUndo {
+    TerritoryState source;
+    TerritoryState destination;
+    Player* issuer;
+    Player* target; //player targeted by a negotiate order
+    Player* defender; //owner of the destination of an advance, nullptr otherwise
+    int8_t defenderStrategy; //index of the strategy of the defender, -1 for none
+    bool hadTruce; //whether the issuer and the target of a negotiate order already had a truce
+    uint8_t type;
+};
+
+/**
+ * The rules of the orders: what makes each kind of order valid and what executing it does to the board.
+ * The Order classes keep the orders issued by the players for the logs and the human player, and execute them through
+ * these functions; records of orders are executed by a switch on their type, without building any Order.
+ */
+namespace OrderKernel {
+    const uint8_t NO_PLAYER = 0xFF; //index of no player
+
+    // the rules print what they do and count the territories they hand over, unless they are applied quietly: an order
+    // applied to be taken back prints nothing and its transfers are neither counted nor told to the map's listener
+    bool validateDeploy(Player *issuer, Territory *destination);
+    void deploy(Player *issuer, int armies, Territory *destination, bool quiet = false);
+    bool validateAdvance(Player *issuer, Territory *source, Territory *destination);
+    void advance(Player *issuer, int armies, Territory *source, Territory *destination, bool quiet = false);
+    bool validateBomb(Player *issuer, Territory *target);
+    void bomb(Player *issuer, Territory *target, bool quiet = false);
+    bool validateBlockade(Player *issuer, Territory *territory);
+    void blockade(Player *issuer, Territory *territory, bool quiet = false);
+    bool validateAirlift(Player *issuer, Territory *source, Territory *destination);
+    void airlift(Player *issuer, int armies, Territory *source, Territory *destination, bool quiet = false);
+    bool validateNegotiate(Player *issuer, Player *target);
+    void negotiate(Player *issuer, Player *target, bool quiet = false);
+
+    /**
+     * @return whether the record would be executed as a valid order, false for a record that is not an order
+     */
+    bool validate(const OrderRecord &record, Map *map, const vector<Player*> &players);
+
+    /**
+     * executes a record of an order, counted and timed like Order::execute
+     * @param players the players the indexes of the record refer to
+     * @return false for a record that is not an order, which is left alone
+     */
+    bool execute(const OrderRecord &record, Map *map, const vector<Player*> &players);
+
+    /**
+     * saves what an order is about to change, see apply
+     * @param type OrderType of the order
+     */
+    OrderUndo capture(uint8_t type, Player *issuer, Territory *source, Territory *destination, Player *target);
+
+    /**
+     * executes a record of an order in place so that it can be taken back, for strategies trying out orders and what-if
+     * analysis: the order is neither validated, counted nor timed, and is applied quietly
+     * @param players the players the indexes of the record refer to
+     * @return what undo needs to take the order back, of type NEGOTIATE + 1 for a record that is not an order
+     */
+    OrderUndo apply(const OrderRecord &record, Map *map, const vector<Player*> &players);
+
+    /**
+     * takes back an applied order: owners, positions in the territory lists of the players, armies, pending armies,
+     * strategy of the defender and truces are restored. Orders applied since must be taken back first.
+     */
+    void undo(const OrderUndo &undo);
+
+    // conversions between the players and territories and their references in records
+    uint8_t indexOf(const vector<Player*> &players, const Player *player);
+    Player* playerOf(const vector<Player*> &players, uint8_t index);
+    int32_t idOf(const Territory *territory);
+    Territory* territoryOf(Map *map, int32_t id);
+}
+
+#endif //COMP345_N11_ORDERKERNEL_H
@@ -4,32 +4,14 @@
 #include <math.h>
 #include <algorithm>
 #include "../PlayerStrategy/PlayerStrategy.h"
+#include "../Stats/Stats.h"
+#include "../Stats/Trace.h"
 
 namespace {
     // Orders are sorted by priority using a custom comparator.
-    bool compareTwoOrders(Order *order1, Order *order2) {
+    bool compareTwoOrders(const unique_ptr<Order> &order1, const unique_ptr<Order> &order2) {
         return order1->getPriority() < order2->getPriority();
     }
-
-/**
- * This function check if a region is able to be attacked by a specific player
- * @param attacker
- * @param target
- * @return true if the attacker already had the target territory
- * or check if there is any diplomacy relations between the attacker and the territory target
- */
-    bool checkIfPossibleToAttack(Player *attacker, Territory *target) {
-        Player *ownerOfTarget = target->getOwner();
-        std::vector<Player *> relations = attacker->getRelations();
-        bool relationsWithHostOfTarget = find(relations.begin(), relations.end(), ownerOfTarget) != relations.end();
-
-        if (relationsWithHostOfTarget) {
-            std::cout << attacker->getName() << " and " << ownerOfTarget->getName()
-                      << " cannot attack each other for the rest of this turn. ";
-        }
-
-        return attacker == ownerOfTarget || !relationsWithHostOfTarget;
-    }
 }
 
 
@@ -42,7 +24,7 @@ Order::Order() : issuer_(nullptr), priority_(4) {}
 
 Order::Order(Player *issuer, int priority) : issuer_(issuer), priority_(priority) {}
 
-Order::Order(const Order &order) : issuer_(order.issuer_), priority_(order.priority_) {}
+Order::Order(const Order &order) : Subject(order), issuer_(order.issuer_), priority_(order.priority_) {}
 
 // Destructor
 Order::~Order() {}
@@ -60,9 +42,19 @@ std::ostream &operator<<(std::ostream &output, const Order &order) {
     return order.print_(output);
 }
 
-void Order::execute() {
-    execute_();
+// Orders that would not pass validation anymore when they are executed, the board having changed since they were
+// issued, are counted, but still executed as they always were.
+bool Order::execute() {
+    ScopedTimer timer(Stats::order(getType()));
+    TraceSpan span(toString(getType()), "order", Trace::isEnabled() && issuer_ != nullptr ? "\"issuer\": \"" + Trace::escape(issuer_->getName()) + "\"" : "");
+    bool valid = validate();
+    if (!valid) {
+        Stats::increment(StatCounter::ORDERS_INVALID);
+    }
+    execute_(false);
+    Stats::increment(StatCounter::ORDERS_EXECUTED);
     notify();
+    return valid;
 }
 
 // Get order priority
@@ -70,11 +62,33 @@ int Order::getPriority() const {
     return priority_;
 }
 
+// Get the player who issued the order
+Player *Order::getIssuer() const {
+    return issuer_;
+}
+
 // Reset the pre-orders-execution game state to the state it was in before the order was placed.
 // If there is no meta-state to reset, the default behaviour is to do nothing.
 
 void Order::undo_() {}
 
+OrderUndo Order::apply() {
+    OrderUndo undo = capture_();
+    execute_(true);
+    return undo;
+}
+
+OrderRecord Order::encode(const vector<Player*> &players) const {
+    OrderRecord record = {static_cast<uint8_t>(getType()), OrderKernel::indexOf(players, issuer_), OrderKernel::NO_PLAYER, 0, 0, 0, 0};
+    encode_(record, players);
+    return record;
+}
+
+// Orders are executed one by one, so in general two orders do not have the effect of a bigger one.
+bool Order::merge(const Order &order) {
+    return false;
+}
+
 
 /**
  * Implementing OrdersList classes
@@ -83,27 +97,24 @@ void Order::undo_() {}
 // Constructors
 OrdersList::OrdersList() {}
 
-OrdersList::OrdersList(const OrdersList &orders) {
+OrdersList::OrdersList(const OrdersList &orders) : Subject(orders) {
     for (const auto &order: orders.orders_) {
-        orders_.push_back(order->clone());
+        orders_.emplace_back(order->clone());
     }
 }
 
 OrdersList::OrdersList(vector<Order *> orders) {
-    this->orders_ = orders;
-}
-
-// Destructor
-OrdersList::~OrdersList() {
-    for (const auto &order: orders_) {
-        delete order;
+    for (const auto &order: orders) {
+        orders_.emplace_back(order);
     }
-    orders_.clear();
 }
 
+// Destructor, the orders are deleted with the list
+OrdersList::~OrdersList() = default;
+
 const OrdersList &OrdersList::operator=(const OrdersList &orders) {
     if (this != &orders) {
-        setOrders(orders.orders_);
+        setOrders(orders.getOrders());
     }
     return *this;
 }
@@ -118,28 +129,37 @@ std::ostream &operator<<(std::ostream &output, const OrdersList &orders) {
 
 // Getter and setter
 std::vector<Order *> OrdersList::getOrders() const {
-    return orders_;
+    std::vector<Order *> orders;
+    orders.reserve(orders_.size());
+    for (const auto &order: orders_) {
+        orders.push_back(order.get());
+    }
+    return orders;
 }
 
 void OrdersList::setOrders(std::vector<Order *> orders) {
-    for (const auto &order: orders_) {
-        delete order;
-    }
     orders_.clear();
-
     for (const auto &order: orders) {
-        orders_.push_back(order->clone());
+        orders_.emplace_back(order->clone());
     }
 }
 
 // Pop the first order in the OrderList according to priority
-Order *OrdersList::popTopOrder() {
-    Order *topOrder = peek();
+unique_ptr<Order> OrdersList::popTopOrder() {
+    if (peek() == nullptr) {
+        return nullptr;
+    }
+    unique_ptr<Order> topOrder = std::move(orders_.front());
     orders_.erase(orders_.begin());
 
     return topOrder;
 }
 
+// Delete all the orders of the list
+void OrdersList::clear() {
+    orders_.clear();
+}
+
 // Get the first order in the OrderList according to priority without removing it
 Order *OrdersList::peek() {
     if (orders_.empty()) {
@@ -148,7 +168,7 @@ Order *OrdersList::peek() {
 
     sort(orders_.begin(), orders_.end(), compareTwoOrders);
 
-    return orders_.front();
+    return orders_.front().get();
 }
 
 // Return the number of orders in the OrdersList
@@ -157,10 +177,23 @@ int OrdersList::size() const {
 }
 
 // Add an order to the OrderList.
-void OrdersList::add(Order *order) {
-    orders_.push_back(order);
-    contentToLog = toString(order->getType());
-    notify();
+void OrdersList::add(Order *order, bool coalesce) {
+    OrderType type = order->getType();
+    bool merged = false;
+    for (size_t i = 0; coalesce && !merged && i < orders_.size(); i++) {
+        merged = orders_[i]->merge(*order);
+    }
+    if (merged) {
+        delete order;
+        Stats::increment(StatCounter::ORDERS_COALESCED);
+    } else {
+        orders_.emplace_back(order);
+    }
+    Stats::increment(StatCounter::ORDERS_ISSUED);
+    if (isObserved()) {
+        contentToLog = toString(type);
+        notify();
+    }
 }
 
 // Move an order within the OrderList from `area` position to `targetRange` position.
@@ -195,9 +228,7 @@ void OrdersList::move(int area, int targetRange) {
  * @param target
  */
 void OrdersList::remove(int target) {
-    auto orderToRemoveIterator = orders_.begin() + target;
-    delete *orderToRemoveIterator;
-    orders_.erase(orderToRemoveIterator);
+    orders_.erase(orders_.begin() + target);
 }
 
 
@@ -249,25 +280,35 @@ void DeployOrder::addArmies(int additional) {
     numberOfArmies_ += additional;
 }
 
-// Checks that the DeployOrder is valid.
-//If the target territory does not belong to the player that issued the order, the order is invalid.
-bool DeployOrder::validate() const {
-    if (issuer_ == nullptr || destination_ == nullptr) {
+// Deploys to the same territory by the same player add up: all the deploy orders are executed before any other order,
+// and a deploy only changes the armies of its own territory.
+bool DeployOrder::merge(const Order &order) {
+    if (order.getType() != DEPLOY || order.getIssuer() != issuer_) {
+        return false;
+    }
+    const DeployOrder &deploy = static_cast<const DeployOrder &>(order);
+    if (deploy.destination_ != destination_) {
         return false;
     }
+    addArmies(deploy.numberOfArmies_);
+    return true;
+}
 
-    std::vector<Territory *> currentPlayerTerritories = issuer_->getTerritories();
-    return find(currentPlayerTerritories.begin(), currentPlayerTerritories.end(), destination_) !=
-           currentPlayerTerritories.end();
+// Checks that the DeployOrder is valid.
+//If the target territory does not belong to the player that issued the order, the order is invalid.
+bool DeployOrder::validate() const {
+    return OrderKernel::validateDeploy(issuer_, destination_);
 }
 
 // Executes the DeployOrder.
 //If the target territory belongs to the player that issued the deploy order, the selected number of armies is
 //added to the number of armies on that territory.
-void DeployOrder::execute_() {
-    destination_->addArmies(numberOfArmies_);
-    destination_->setPendingIncomingArmies(0);
-    std::cout << "Deployed " << numberOfArmies_ << " armies to " << destination_->getName() << "." << std::endl;
+void DeployOrder::execute_(bool quiet) {
+    OrderKernel::deploy(issuer_, numberOfArmies_, destination_, quiet);
+}
+
+OrderUndo DeployOrder::capture_() const {
+    return OrderKernel::capture(DEPLOY, issuer_, nullptr, destination_, nullptr);
 }
 
 // Reset the pre-orders-execution game state to the state it was in before the order was placed.
@@ -282,6 +323,19 @@ OrderType DeployOrder::getType() const {
     return DEPLOY;
 }
 
+void DeployOrder::encode_(OrderRecord &record, const vector<Player*> &players) const {
+    record.destination = OrderKernel::idOf(destination_);
+    record.armies = numberOfArmies_;
+}
+
+int DeployOrder::getNumberOfArmies() const {
+    return numberOfArmies_;
+}
+
+Territory *DeployOrder::getDestination() const {
+    return destination_;
+}
+
 
 /**
  * Implementing Advance Order class
@@ -332,78 +386,16 @@ Order *AdvanceOrder::clone() const {
 // If the source territory does not belong to the player that issued the order, the order is invalid.
 // If the target territory is not adjacent to the source territory, the order is invalid.
 bool AdvanceOrder::validate() const {
-    if (issuer_ == nullptr || source_ == nullptr || destination_ == nullptr) {
-        return false;
-    }
-
-    std::vector<Territory *> currentTerritoriesOfPlayer = issuer_->getTerritories();
-    bool validSourceTerritory = find(currentTerritoriesOfPlayer.begin(), currentTerritoriesOfPlayer.end(), source_) !=
-                                currentTerritoriesOfPlayer.end();
-    bool hasAnyArmiesToAdvance = source_->getNumberOfArmies() > 0;
-
-    return validSourceTerritory && hasAnyArmiesToAdvance && checkIfPossibleToAttack(issuer_, destination_);
+    return OrderKernel::validateAdvance(issuer_, source_, destination_);
 }
 
 // Executes the Advance Order.
-void AdvanceOrder::execute_() {
-    Player *defender = destination_->getOwner();
-    bool offensive = issuer_ != defender;
-
-    // Recalculate what number of armies may want to truely be moved if the kingdom of the territory has modified because of an attack
-    int movableArmiesFromSource = numberOfArmies_;
-    if (issuer_->getStrategy() != GameEngine::strategyType.at(strategy::Cheater)) {
-        movableArmiesFromSource = std::min(source_->getNumberOfArmies(), numberOfArmies_);
-    }
-    if(movableArmiesFromSource>0  && defender->getStrategy() == GameEngine::strategyType.at(strategy::Neutral)){
-        cout<<"**" << endl;
-        cout<< "STRATEGY CHANGE: an attack happen to one of the neutral player territories....Now neutral player becomes aggressive player"<<endl;
-        cout<<"**" << endl;
-        defender->setStrategy(strategy::Aggressive);
-    }
-
-    std::cout << "=======An Advanced Order is executed ========";
-    if (offensive) {
-        // Simulate battle
-        source_->removeArmies(movableArmiesFromSource);
-
-        //Each attacking army unit involved has 60% chances of killing one defending army.
-        int defendersKilled = round(movableArmiesFromSource * 0.6);
-        //At the same time, each defending army unit has 70% chances of killing one attacking army unit.
-        int attackersKilled = round(destination_->getNumberOfArmies() * 0.7);
-
-        int survivingAttackers = std::max(movableArmiesFromSource - attackersKilled, 0);
-        int survivingDefenders = std::max(destination_->getNumberOfArmies() - defendersKilled, 0);
-        destination_->removeArmies(defendersKilled);
-
-        // Failed attack
-        if (survivingDefenders > 0 || survivingAttackers <= 0) {
-            source_->addArmies(survivingAttackers);
-            std::cout << "Failed attack on " << destination_->getName() << " with " << survivingDefenders
-                      << " enemy armies left standing.";
-
-            if (survivingAttackers > 0) {
-                std::cout << " Retreating " << survivingAttackers << " attacking armies back to " << source_->getName()
-                          << std::endl;
-            } else {
-                std::cout << std::endl;
-            }
-        }
-            // Successful attack: If all the defender's armies are eliminated, the attacker captures the territory
-        else {
-            std::cout << "=======Successful Attack: (2) Ownership of a territory is transferred to the attacking player if a territory is conquered. ========" << endl;
-            defender->transferTerritory(destination_, issuer_);
-            destination_->addArmies(survivingAttackers);
-            std::cout << "Attack is successful on the " << destination_->getName() << ". " << survivingAttackers
-                      << " armies now attacked and owns this territory." << std::endl;
-        }
-    } else {
-        source_->removeArmies(movableArmiesFromSource);
-        destination_->addArmies(movableArmiesFromSource);
-        std::cout << "Advanced " << movableArmiesFromSource << " armies from " << source_->getName() << " to "
-                  << destination_->getName() << "." << std::endl;
-    }
+void AdvanceOrder::execute_(bool quiet) {
+    OrderKernel::advance(issuer_, numberOfArmies_, source_, destination_, quiet);
+}
 
-    source_->setPendingOutgoingArmies(0);
+OrderUndo AdvanceOrder::capture_() const {
+    return OrderKernel::capture(ADVANCE, issuer_, source_, destination_, nullptr);
 }
 
 // Reset the pre-orders-execution game state to the state it was in before the order was placed.
@@ -418,6 +410,24 @@ OrderType AdvanceOrder::getType() const {
     return ADVANCE;
 }
 
+void AdvanceOrder::encode_(OrderRecord &record, const vector<Player*> &players) const {
+    record.source = OrderKernel::idOf(source_);
+    record.destination = OrderKernel::idOf(destination_);
+    record.armies = numberOfArmies_;
+}
+
+int AdvanceOrder::getNumberOfArmies() const {
+    return numberOfArmies_;
+}
+
+Territory *AdvanceOrder::getSource() const {
+    return source_;
+}
+
+Territory *AdvanceOrder::getDestination() const {
+    return destination_;
+}
+
 
 /**
  * Implementing Bomb Order class
@@ -461,23 +471,17 @@ Order *BombOrder::clone() const {
 //If the target belongs to the player that issued the order, the order is invalid.
 //If the target territory is not adjacent to one of the territory owned by the player issuing the order, then the order is invalid.
 bool BombOrder::validate() const {
-    if (issuer_ == nullptr || target_ == nullptr) {
-        return false;
-    }
-
-    std::vector<Territory *> currentPlayerTerritories = issuer_->getTerritories();
-    bool validTargetTerritory = find(currentPlayerTerritories.begin(), currentPlayerTerritories.end(), target_) ==
-                                currentPlayerTerritories.end();
-    return validTargetTerritory && checkIfPossibleToAttack(issuer_, target_);
+    return OrderKernel::validateBomb(issuer_, target_);
 }
 
 // Executes the BombOrder.
 //If the target belongs to an enemy player, half of the armies are removed from this territory.
-void BombOrder::execute_() {
-    int armiesOnTarget = target_->getNumberOfArmies();
-    target_->removeArmies(armiesOnTarget / 2);
-    std::cout << "Bombed " << armiesOnTarget / 2 << " enemy armies on " << target_->getName() << ". ";
-    std::cout << target_->getNumberOfArmies() << " remaining." << std::endl;
+void BombOrder::execute_(bool quiet) {
+    OrderKernel::bomb(issuer_, target_, quiet);
+}
+
+OrderUndo BombOrder::capture_() const {
+    return OrderKernel::capture(BOMB, issuer_, nullptr, target_, nullptr);
 }
 
 // Get the type of the Order sub-class
@@ -485,6 +489,14 @@ OrderType BombOrder::getType() const {
     return BOMB;
 }
 
+void BombOrder::encode_(OrderRecord &record, const vector<Player*> &players) const {
+    record.destination = OrderKernel::idOf(target_);
+}
+
+Territory *BombOrder::getTarget() const {
+    return target_;
+}
+
 
 /**
  * Implementing Blockade Order class
@@ -527,22 +539,16 @@ Order *BlockadeOrder::clone() const {
 // Checks that the BlockadeOrder is valid.
 //If the target territory belongs to an enemy player, the order is declared invalid.
 bool BlockadeOrder::validate() const {
-    if (issuer_ == nullptr || territory_ == nullptr) {
-        return false;
-    }
-
-    std::vector<Territory *> currentPlayerTerritories = issuer_->getTerritories();
-    return find(currentPlayerTerritories.begin(), currentPlayerTerritories.end(), territory_) !=
-           currentPlayerTerritories.end();
+    return OrderKernel::validateBlockade(issuer_, territory_);
 }
 
 // Executes the BlockadeOrder.
-void BlockadeOrder::execute_() {
-    //the number of armies on the territory is doubled and the ownership of the territory is transferred to the Neutral player
-    territory_->addArmies(territory_->getNumberOfArmies());
-    GameEngine::assignToNeutralPlayer(territory_);
-    std::cout << "Blockade called on " << territory_->getName() << ". ";
-    std::cout << territory_->getNumberOfArmies() << " neutral armies now occupy this territory." << std::endl;
+void BlockadeOrder::execute_(bool quiet) {
+    OrderKernel::blockade(issuer_, territory_, quiet);
+}
+
+OrderUndo BlockadeOrder::capture_() const {
+    return OrderKernel::capture(BLOCKADE, issuer_, nullptr, territory_, nullptr);
 }
 
 // Get the type of the Order sub-class
@@ -550,6 +556,14 @@ OrderType BlockadeOrder::getType() const {
     return BLOCKADE;
 }
 
+void BlockadeOrder::encode_(OrderRecord &record, const vector<Player*> &players) const {
+    record.destination = OrderKernel::idOf(territory_);
+}
+
+Territory *BlockadeOrder::getTerritory() const {
+    return territory_;
+}
+
 
 /**
  * Implementing Airlift Order class
@@ -598,34 +612,16 @@ Order *AirliftOrder::clone() const {
 // Checks that the AirliftOrder is valid.
 // If the source or target does not belong to the player that issued the order, the order is invalid.
 bool AirliftOrder::validate() const {
-    if (issuer_ == nullptr || source_ == nullptr || destination_ == nullptr || source_ == destination_) {
-        return false;
-    }
-
-    std::vector<Territory *> currentPlayerTerritories = issuer_->getTerritories();
-
-    bool validSourceTerritory = find(currentPlayerTerritories.begin(), currentPlayerTerritories.end(), source_) !=
-                                currentPlayerTerritories.end();
-    bool validDestinationTerritory =
-            find(currentPlayerTerritories.begin(), currentPlayerTerritories.end(), destination_) !=
-            currentPlayerTerritories.end();
-    bool hasAnyArmiesToAirlift = source_->getNumberOfMovableArmies() > 0;
-
-    return validSourceTerritory && validDestinationTerritory && hasAnyArmiesToAirlift;
+    return OrderKernel::validateAirlift(issuer_, source_, destination_);
 }
 
 // Executes the AirliftOrder.
-void AirliftOrder::execute_() {
-    // Recalculate how many armies could actually be moved in case the state of the territory has changed due to an attack
-    int movableArmiesFromSource = std::min(source_->getNumberOfArmies(), numberOfArmies_);
-
-    destination_->addArmies(movableArmiesFromSource);
-    source_->removeArmies(movableArmiesFromSource);
-    source_->setPendingOutgoingArmies(0);
+void AirliftOrder::execute_(bool quiet) {
+    OrderKernel::airlift(issuer_, numberOfArmies_, source_, destination_, quiet);
+}
 
-    //Selected number of armies is moved from the source to the target territory.
-    std::cout << "Airlifted " << movableArmiesFromSource << " armies from " << source_->getName() << " to "
-              << destination_->getName() << "." << std::endl;
+OrderUndo AirliftOrder::capture_() const {
+    return OrderKernel::capture(AIRLIFT, issuer_, source_, destination_, nullptr);
 }
 
 // Reset the pre-orders-execution game state to the state it was in before the order was placed.
@@ -640,6 +636,24 @@ OrderType AirliftOrder::getType() const {
     return AIRLIFT;
 }
 
+void AirliftOrder::encode_(OrderRecord &record, const vector<Player*> &players) const {
+    record.source = OrderKernel::idOf(source_);
+    record.destination = OrderKernel::idOf(destination_);
+    record.armies = numberOfArmies_;
+}
+
+int AirliftOrder::getNumberOfArmies() const {
+    return numberOfArmies_;
+}
+
+Territory *AirliftOrder::getSource() const {
+    return source_;
+}
+
+Territory *AirliftOrder::getDestination() const {
+    return destination_;
+}
+
 
 /**
  * Implementing Negotiate Order class
@@ -683,21 +697,18 @@ Order *NegotiateOrder::clone() const {
 // Checks that the NegotiateOrder is valid.
 //If the target is the player issuing the order, then the order is invalid.
 bool NegotiateOrder::validate() const {
-    if (issuer_ == nullptr || target_ == nullptr) {
-        return false;
-    }
-
-    return issuer_ != target_;
+    return OrderKernel::validateNegotiate(issuer_, target_);
 }
 
 // Executes the NegotiateOrder.
 //The effect is that any attack that may be declared between territories
 //of the player issuing the negotiate order and the target player will result in an invalid order.
-void NegotiateOrder::execute_() {
-    issuer_->addDiplomaticRelation(target_);
-    target_->addDiplomaticRelation(issuer_);
-    std::cout << "Negotiated diplomacy between " << issuer_->getName() << " and " << target_->getName() << "."
-              << std::endl;
+void NegotiateOrder::execute_(bool quiet) {
+    OrderKernel::negotiate(issuer_, target_, quiet);
+}
+
+OrderUndo NegotiateOrder::capture_() const {
+    return OrderKernel::capture(NEGOTIATE, issuer_, nullptr, nullptr, target_);
 }
 
 // Get the type of the Order sub-class
@@ -705,6 +716,14 @@ OrderType NegotiateOrder::getType() const {
     return NEGOTIATE;
 }
 
+void NegotiateOrder::encode_(OrderRecord &record, const vector<Player*> &players) const {
+    record.target = OrderKernel::indexOf(players, target_);
+}
+
+Player *NegotiateOrder::getTarget() const {
+    return target_;
+}
+
 // for LoggingObserver
 string Order::stringToLog() {
     return "Executing Order";
@@ -716,9 +735,8 @@ string OrdersList::stringToLog(){
 
 void OrdersList::removeOrder(Order *An_order) {
     for (int i = 0 ; i<orders_.size();i++){
-        if (this->orders_.at(i)== An_order){
+        if (this->orders_.at(i).get() == An_order){
             orders_.erase(next(begin(orders_), + i));
-            delete An_order;
             break;
         }
     }
@@ -11,7 +11,9 @@
 #include "../Map/Map.h"
 #include "../Player/Player.h"
 #include "../Logging/LoggingObserver.h"
+#include "OrderKernel.h"
 #include <iostream>
+#include <memory>
 #include <vector>
 using namespace std;
 class Player;
@@ -31,6 +33,10 @@ enum OrderType : short
 
 string toString (short enumType);
 
+/**
+ * An order issued by a player, kept for the logs and the human player. The rules of the orders live in OrderKernel,
+ * which the orders execute through, and an order is stored in game records as its OrderRecord.
+ */
 class Order : public Subject
 {
 public:
@@ -41,12 +47,36 @@ public:
     friend std::ostream &operator<<(std::ostream &output, const Order &order);\
 //    ???
 
-    void execute();
+    /**
+     * @return whether the order was valid when it was executed
+     */
+    bool execute();
     int getPriority() const;
+    Player* getIssuer() const;
     virtual Order* clone() const = 0;
     virtual bool validate() const = 0;
     virtual OrderType getType() const = 0;
 
+    /**
+     * adds another order to this one when executing this order alone has exactly the effect of executing both
+     * @return false if the orders cannot be merged, the default
+     */
+    virtual bool merge(const Order &order);
+
+    /**
+     * @param players the players the indexes of the record refer to
+     * @return the order as plain data
+     */
+    OrderRecord encode(const vector<Player*> &players) const;
+
+    /**
+     * executes the order in place so that it can be taken back with OrderKernel::undo, without validating, counting
+     * nor notifying it, and quietly: nothing is printed and the territories it hands over are neither counted nor
+     * recorded, for strategies trying out orders
+     * @return what the order changed
+     */
+    OrderUndo apply();
+
     // Iloggable
     virtual string stringToLog();
 
@@ -58,15 +88,18 @@ protected:
 
     const Order &operator=(const Order &order);
     virtual std::ostream &print_(std::ostream &output) const = 0;
-    virtual void execute_() = 0;
+    virtual void execute_(bool quiet) = 0; //quiet when the order is applied to be taken back, see OrderKernel
     virtual void undo_();
+    virtual void encode_(OrderRecord &record, const vector<Player*> &players) const = 0;
+    virtual OrderUndo capture_() const = 0;
 
 private:
     int priority_;
 };
 
 /***
- * The OrderList class contains...
+ * The OrderList class contains the orders issued by a player, which it owns: an order added to the list is deleted
+ * by the list once it is removed, unless it is taken out of it by popTopOrder
  */
 class OrdersList : public Subject
 {
@@ -74,16 +107,22 @@ public:
 
     OrdersList();
     OrdersList(const OrdersList &orders);
-    OrdersList(vector<Order *> orders);
+    OrdersList(vector<Order *> orders); //takes ownership of the orders
     ~OrdersList();
     const OrdersList &operator=(const OrdersList &orders);
     friend std::ostream &operator<<(std::ostream &output, const OrdersList &orders);
-    std::vector<Order*> getOrders() const;
-    void setOrders(std::vector<Order*> orders);
-    Order* popTopOrder();
+    std::vector<Order*> getOrders() const; //the orders stay owned by the list
+    void setOrders(std::vector<Order*> orders); //copies of the orders
+    unique_ptr<Order> popTopOrder();
     Order* peek();
     int size() const;
-    void add(Order* order);
+    /**
+     * takes ownership of the order
+     * @param coalesce whether the order may be merged into an order of the list it adds to, see Order::merge,
+     * in which case it is deleted
+     */
+    void add(Order* order, bool coalesce = false);
+    void clear();
     void move(int area, int targetRange);
     void remove(int target);
     void removeOrder(Order * order);
@@ -91,7 +130,7 @@ public:
     // Iloggable
     virtual string stringToLog();
 private:
-    std::vector<Order*> orders_;
+    std::vector<unique_ptr<Order>> orders_;
 };
 
 /**
@@ -107,14 +146,19 @@ public:
     const DeployOrder &operator=(const DeployOrder &order);
     Order* clone() const;
     void addArmies(int additional);
+    bool merge(const Order &order);
     bool validate() const;
     OrderType getType() const;
+    int getNumberOfArmies() const;
+    Territory* getDestination() const;
 
     // Iloggable
     virtual string stringToLog();
 protected:
-    void execute_();
+    void execute_(bool quiet);
     void undo_();
+    void encode_(OrderRecord &record, const vector<Player*> &players) const;
+    OrderUndo capture_() const;
     std::ostream &print_(std::ostream &output) const;
 
 private:
@@ -137,12 +181,17 @@ public:
     Order* clone() const;
     bool validate() const;
     OrderType getType() const;
+    int getNumberOfArmies() const;
+    Territory* getSource() const;
+    Territory* getDestination() const;
 
     // Iloggable
     virtual string stringToLog();
 protected:
-    void execute_();
+    void execute_(bool quiet);
     void undo_();
+    void encode_(OrderRecord &record, const vector<Player*> &players) const;
+    OrderUndo capture_() const;
     std::ostream &print_(std::ostream &output) const;
 
 private:
@@ -162,11 +211,14 @@ public:
     Order* clone() const;
     bool validate() const;
     OrderType getType() const;
+    Player* getTarget() const;
 
     // Iloggable
     virtual string stringToLog();
 protected:
-    void execute_();
+    void execute_(bool quiet);
+    void encode_(OrderRecord &record, const vector<Player*> &players) const;
+    OrderUndo capture_() const;
     std::ostream &print_(std::ostream &output) const;
 
 private:
@@ -187,12 +239,17 @@ public:
     Order* clone() const;
     bool validate() const;
     OrderType getType() const;
+    int getNumberOfArmies() const;
+    Territory* getSource() const;
+    Territory* getDestination() const;
 
     // Iloggable
     virtual string stringToLog();
 protected:
-    void execute_();
+    void execute_(bool quiet);
     void undo_();
+    void encode_(OrderRecord &record, const vector<Player*> &players) const;
+    OrderUndo capture_() const;
     std::ostream &print_(std::ostream &output) const;
 
 private:
@@ -215,11 +272,14 @@ public:
     Order* clone() const;
     bool validate() const;
     OrderType getType() const;
+    Territory* getTarget() const;
 
     // Iloggable
     virtual string stringToLog();
 protected:
-    void execute_();
+    void execute_(bool quiet);
+    void encode_(OrderRecord &record, const vector<Player*> &players) const;
+    OrderUndo capture_() const;
     std::ostream &print_(std::ostream &output) const;
 
 private:
@@ -240,11 +300,14 @@ public:
     Order* clone() const;
     bool validate() const;
     OrderType getType() const;
+    Territory* getTerritory() const;
 
     // Iloggable
     virtual string stringToLog();
 protected:
-    void execute_();
+    void execute_(bool quiet);
+    void encode_(OrderRecord &record, const vector<Player*> &players) const;
+    OrderUndo capture_() const;
     std::ostream &print_(std::ostream &output) const;
 
 private:
@@ -3,7 +3,179 @@
 //
 
 #include "../orders/Orders.h"
+#include "../orders/OrderKernel.h"
+#include "../orders/LegalMoves.h"
 #include "../gameengine/GameEngine.h"
+#include "../Stats/Stats.h"
+
+namespace {
+    // what applying an order may change, so that taking it back can be checked to restore all of it
+    struct BoardState {
+        uint64_t boardHash;
+        uint64_t ownershipHash;
+        vector<vector<Territory*>> territories;
+        vector<bool> truces;
+        long territoriesTransferred;
+
+        bool operator==(const BoardState &state) const {
+            return boardHash == state.boardHash && ownershipHash == state.ownershipHash &&
+                   territories == state.territories && truces == state.truces &&
+                   territoriesTransferred == state.territoriesTransferred;
+        }
+    };
+
+    BoardState boardStateOf(Map *map, const vector<Player*> &players) {
+        BoardState state = {map->getBoardHash(), map->getOwnershipHash(), {}, {},
+                            Stats::get(StatCounter::TERRITORIES_TRANSFERRED)};
+        for (auto &player : players) {
+            state.territories.push_back(player->getTerritories());
+            for (auto &other : players) {
+                state.truces.push_back(player->hasDiplomaticRelation(other));
+            }
+        }
+        return state;
+    }
+
+    // every kind of order is applied in place on a real map, the orders piling up, then they are taken back one by one
+    void applyUndoDriver() {
+        std::cout << "===== " << "Orders applied then taken back on the map of Canada =====" << std::endl;
+        Map* map = MapLoader::loadMapFile("../Map/maps/canada.map");
+        if (map == nullptr) {
+            std::cout << "The map could not be loaded" << std::endl;
+            return;
+        }
+        Player* player = new Player("Thong", strategy::Aggressive);
+        Player* enemy = new Player("Khoa", strategy::Benevolent);
+        for (int i = 0; i < map->getNumTerritories(); i++) {
+            (i % 2 == 0 ? player : enemy)->addTerritory(map->getTerritories()[i]);
+            map->getTerritories()[i]->setNumberOfArmies(4);
+        }
+        vector<Player*> players = {player, enemy};
+
+        // a territory of the player bordering one of the enemy, captured by the advance then bombed and airlifted to
+        Territory* source = nullptr;
+        Territory* target = nullptr;
+        for (auto &territory : player->getTerritories()) {
+            for (int i = 0; i < territory->getNumAdjTerritories() && target == nullptr; i++) {
+                if (territory->getAdjTerritories()[i]->getOwner() == enemy) {
+                    source = territory;
+                    target = territory->getAdjTerritories()[i];
+                }
+            }
+        }
+        if (target == nullptr) {
+            std::cout << "No territory of the player borders the enemy" << std::endl;
+            return;
+        }
+        Territory* other = player->getTerritories().back();
+        vector<Order*> orders = {new DeployOrder(player, 3, source), new AdvanceOrder(player, 20, source, target),
+                                 new BombOrder(player, target), new BlockadeOrder(player, other),
+                                 new AirliftOrder(player, 2, source, target),
+                                 new NegotiateOrder(player, enemy)};
+
+        // the orders are applied either as orders or as records, which must change the board the same way
+        vector<BoardState> states;
+        vector<OrderUndo> undos;
+        for (size_t i = 0; i < orders.size(); i++) {
+            states.push_back(boardStateOf(map, players));
+            undos.push_back(i % 2 == 0 ? orders[i]->apply() : OrderKernel::apply(orders[i]->encode(players), map, players));
+            std::cout << "Applied " << *orders[i] << ": the board " << (boardStateOf(map, players) == states.back() ? "did not change" : "changed") << std::endl;
+        }
+        bool restored = true;
+        while (!undos.empty()) {
+            OrderKernel::undo(undos.back());
+            bool same = boardStateOf(map, players) == states.back();
+            std::cout << "Took back " << *orders[undos.size() - 1] << ": the board is " << (same ? "" : "NOT ") << "as it was before" << std::endl;
+            restored = restored && same;
+            undos.pop_back();
+            states.pop_back();
+        }
+        std::cout << "===== " << (restored ? "Every order was taken back exactly" : "Some orders were not taken back exactly") << " =====" << std::endl;
+
+        for (auto &order : orders) {
+            delete order;
+        }
+        delete player;
+        delete enemy;
+        delete map;
+    }
+
+    // deploys of a player to the same territory are merged into one order when they are added to a list coalescing them
+    void mergeDriver() {
+        std::cout << "===== " << "Deploys added to an orders list that merges them =====" << std::endl;
+        Territory* columbia = new Territory(1, "Columbia", 0, nullptr);
+        Territory* newyork = new Territory(2, "NewYork", 0, nullptr);
+        Player* player = new Player("Thong");
+        player->addTerritory(columbia);
+        player->addTerritory(newyork);
+
+        OrdersList ordersList;
+        ordersList.add(new DeployOrder(player, 3, columbia), true);
+        ordersList.add(new DeployOrder(player, 4, newyork), true);
+        ordersList.add(new DeployOrder(player, 5, columbia), true);
+        std::cout << "Deploys of 3 armies to Columbia, 4 to NewYork then 5 to Columbia give " << ordersList.size() << " orders:" << std::endl;
+        for (const auto &order : ordersList.getOrders()) {
+            std::cout << *order << std::endl;
+        }
+        auto first = dynamic_cast<DeployOrder*>(ordersList.getOrders().front());
+        bool merged = ordersList.size() == 2 && first != nullptr && first->getDestination() == columbia &&
+                      first->getNumberOfArmies() == 8;
+        std::cout << "===== " << (merged ? "The deploys to Columbia were merged into one order of 8 armies" : "The deploys to Columbia were NOT merged") << " =====" << std::endl;
+
+        delete player;
+        delete columbia;
+        delete newyork;
+    }
+
+    // the advances enumerated for a player leave its territories with movable armies and spare the players it has a truce with
+    void legalMovesDriver() {
+        std::cout << "===== " << "Advances of a player having a truce, on the map of Canada =====" << std::endl;
+        Map* map = MapLoader::loadMapFile("../Map/maps/canada.map");
+        if (map == nullptr) {
+            std::cout << "The map could not be loaded" << std::endl;
+            return;
+        }
+        Player* player = new Player("Thong");
+        Player* enemy = new Player("Khoa");
+        Player* ally = new Player("Sarah");
+        vector<Player*> players = {player, enemy, ally};
+        for (int i = 0; i < map->getNumTerritories(); i++) {
+            players[i % players.size()]->addTerritory(map->getTerritories()[i]);
+            map->getTerritories()[i]->setNumberOfArmies(2);
+        }
+        Territory* empty = player->getTerritories().front();
+        empty->setNumberOfArmies(0);
+        player->addDiplomaticRelation(ally);
+
+        // the advances expected, found by walking every border of the territories of the player
+        size_t expected = 0;
+        size_t spared = 0;
+        for (auto &territory : player->getTerritories()) {
+            for (int i = 0; territory != empty && i < territory->getNumAdjTerritories(); i++) {
+                bool toAlly = territory->getAdjTerritories()[i]->getOwner() == ally;
+                expected += toAlly ? 0 : 1;
+                spared += toAlly ? 1 : 0;
+            }
+        }
+
+        LegalMoves advances(player, 1u << ADVANCE);
+        vector<LegalMove> moves = advances.remaining();
+        bool legal = true;
+        for (auto &move : moves) {
+            legal = legal && move.type == ADVANCE && move.source != empty && move.source->getOwner() == player &&
+                    move.destination->getOwner() != ally && move.armies == 2;
+        }
+        std::cout << moves.size() << " advances are enumerated, " << expected << " were expected, " << spared
+                  << " borders with Sarah, who has a truce with Thong, are spared" << std::endl;
+        std::cout << "===== " << (legal && moves.size() == expected ? "The advances skip the truce partner and " + empty->getName() + ", which has no armies"
+                                                                       : "Some advances are NOT legal") << " =====" << std::endl;
+
+        for (auto &each : players) {
+            delete each;
+        }
+        delete map;
+    }
+}
 
 void  orderDriver()
 {
@@ -72,16 +244,16 @@ void  orderDriver()
     //(3) one card is given to a player if they conquer at least one territory in a turn (not more than one card per turn)
     if (player->getTerritories().size() >=1) {
         std::cout << "========== " << "Player Thong wins 1 more territory in this turn because originally he has only 2 territories. He will be given 1 card ==========" << std::endl;
-        vector<Card*>cards;
+        vector<Card>cards;
         // Add random card
-        cards.push_back(new Card("bomb"));
+        cards.push_back(Card("bomb"));
         Hand * handOfCards = new Hand(cards);
         player->setPlayerCards(handOfCards);
     } else if (enemy->getTerritories().size() >= 1) {
         std::cout << "========== " << "Player Khoa wins 1 more territory in this turn because originally he has only 1 territory. He will be given 1 card ==========" << std::endl;
-        vector<Card*>cards;
+        vector<Card>cards;
         // Add random card
-        cards.push_back(new Card("bomb"));
+        cards.push_back(Card("bomb"));
         Hand * handOfCards = new Hand(cards);
         enemy->setPlayerCards(handOfCards);
     }
@@ -118,5 +290,9 @@ void  orderDriver()
     delete california;
     california = NULL;
 
+    applyUndoDriver();
+    mergeDriver();
+    legalMovesDriver();
+
 //    GameEngine::clearPlayerList();
 }
\ No newline at end of file
@@ -0,0 +1,98 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "DiplomacyMatrix.h"
+#include "Player.h"
+
+DiplomacyMatrix::DiplomacyMatrix() : turn(1) { }
+
+DiplomacyMatrix::~DiplomacyMatrix() {
+    // nothing, the players are owned by the game engine
+}
+
+// index of a player in the matrix, -1 if the player was not registered in this matrix since its last reset
+int DiplomacyMatrix::indexOf(const Player *player) const {
+    if (player == nullptr || player->getDiplomacy() != this) {
+        return -1;
+    }
+    int index = player->getDiplomacyIndex();
+    if (index < 0 || index >= static_cast<int>(players.size()) || players[index] != player) {
+        return -1;
+    }
+    return index;
+}
+
+void DiplomacyMatrix::registerPlayer(Player *player) {
+    if (player == nullptr || indexOf(player) >= 0) {
+        return;
+    }
+    size_t oldSize = players.size();
+    size_t newSize = oldSize + 1;
+
+    // copies the rows in the bigger matrix, the new row and column start without any truce
+    vector<unsigned> newStamps(newSize * newSize, 0);
+    for (size_t i = 0; i < oldSize; i++) {
+        for (size_t j = 0; j < oldSize; j++) {
+            newStamps[i * newSize + j] = stamps[i * oldSize + j];
+        }
+    }
+    stamps.swap(newStamps);
+    players.push_back(player);
+    player->setDiplomacy(this, static_cast<int>(oldSize));
+}
+
+// the players may already be deleted, they are not touched: their stale index is detected by indexOf
+void DiplomacyMatrix::reset() {
+    players.clear();
+    stamps.clear();
+    turn = 1;
+}
+
+void DiplomacyMatrix::nextTurn() {
+    turn++;
+}
+
+void DiplomacyMatrix::addTruce(Player *player, Player *anotherPlayer) {
+    registerPlayer(player);
+    registerPlayer(anotherPlayer);
+    int i = indexOf(player);
+    int j = indexOf(anotherPlayer);
+    if (i < 0 || j < 0) {
+        return;
+    }
+    size_t size = players.size();
+    stamps[i * size + j] = turn;
+    stamps[j * size + i] = turn;
+}
+
+void DiplomacyMatrix::removeTruce(const Player *player, const Player *anotherPlayer) {
+    int i = indexOf(player);
+    int j = indexOf(anotherPlayer);
+    if (i < 0 || j < 0) {
+        return;
+    }
+    size_t size = players.size();
+    stamps[i * size + j] = 0;
+    stamps[j * size + i] = 0;
+}
+
+bool DiplomacyMatrix::hasTruce(const Player *player, const Player *anotherPlayer) const {
+    int i = indexOf(player);
+    int j = indexOf(anotherPlayer);
+    return i >= 0 && j >= 0 && stamps[i * players.size() + j] == turn;
+}
+
+vector<Player *> DiplomacyMatrix::getTruces(const Player *player) const {
+    vector<Player*> truces;
+    int i = indexOf(player);
+    if (i < 0) {
+        return truces;
+    }
+    for (size_t j = 0; j < players.size(); j++) {
+        if (stamps[i * players.size() + j] == turn) {
+            truces.push_back(players[j]);
+        }
+    }
+    return truces;
+}
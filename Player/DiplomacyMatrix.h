@@ -0,0 +1,64 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#ifndef COMP345_N11_DIPLOMACYMATRIX_H
+#define COMP345_N11_DIPLOMACYMATRIX_H
+
+#include <vector>
+using namespace std;
+
+class Player;
+
+/**
+ * Truces negotiated between the players of a game.
+ * Every pair of players has a cell stamped with the turn its truce was negotiated in, and a truce only holds during
+ * that turn: moving to the next turn ends all the truces at once without touching the matrix, and checking whether two
+ * players can attack each other is O(1).
+ */
+class DiplomacyMatrix {
+public:
+    DiplomacyMatrix();
+    DiplomacyMatrix(const DiplomacyMatrix &anotherMatrix) = delete;
+    DiplomacyMatrix& operator = (const DiplomacyMatrix &anotherMatrix) = delete;
+    ~DiplomacyMatrix();
+
+    /**
+     * gives a player a row and a column of the matrix, players already registered keep theirs
+     * @param player
+     */
+    void registerPlayer(Player *player);
+
+    /**
+     * forgets all the players and their truces, for a new game
+     * the players are not accessed, so this can be called after they were deleted
+     */
+    void reset();
+
+    /**
+     * ends the truces of the current turn
+     */
+    void nextTurn();
+
+    void addTruce(Player *player, Player *anotherPlayer);
+
+    /**
+     * ends the truce of a pair of players, as if they never negotiated
+     */
+    void removeTruce(const Player *player, const Player *anotherPlayer);
+    bool hasTruce(const Player *player, const Player *anotherPlayer) const;
+
+    /**
+     * players having a truce with a player during the current turn
+     */
+    vector<Player*> getTruces(const Player *player) const;
+
+private:
+    vector<Player*> players;
+    vector<unsigned> stamps; // players.size() x players.size(), turn in which the truce of a pair was negotiated
+    unsigned turn; // stamps are 0 when the pair never negotiated, turns start at 1
+
+    int indexOf(const Player *player) const;
+};
+
+#endif //COMP345_N11_DIPLOMACYMATRIX_H
@@ -8,6 +8,10 @@
 #include <stdlib.h>
 #include <ctime>
 #include "math.h"
+#include "../Stats/Stats.h"
+#include "DiplomacyMatrix.h"
+#include <algorithm>
+#include <unordered_set>
 
 
 using namespace std;
@@ -17,8 +21,8 @@ using namespace std;
  */
 Player::Player() {
     name = "anonymous";
-    playerCards = new Hand();
-    playerOrdersList = new OrdersList();
+    playerCards.reset(new Hand());
+    playerOrdersList.reset(new OrdersList());
     vector<Territory*> territories;
     neutral = false;
 }
@@ -33,8 +37,8 @@ Player::Player() {
 Player::Player(string Name, vector<Territory *> &territories) {
     this->name = Name;
     this->territories = territories;
-    this->playerCards = new Hand();
-    this->playerOrdersList = new OrdersList();
+    this->playerCards.reset(new Hand());
+    this->playerOrdersList.reset(new OrdersList());
     neutral = false;
     }
 
@@ -44,8 +48,8 @@ Player::Player(string Name, vector<Territory *> &territories) {
  * @param name
   */
 Player::Player(string name) : name(name), neutral(false) {
-        playerCards = new Hand();
-        playerOrdersList = new OrdersList();
+        playerCards.reset(new Hand());
+        playerOrdersList.reset(new OrdersList());
         vector<Territory*> territories;
         reinforcement_pool = 0;
         ps = nullptr;
@@ -57,8 +61,8 @@ Player::Player(string name) : name(name), neutral(false) {
  */
 Player::Player(const Player &anotherPlayer) {
     this->name = anotherPlayer.name +"_copy";
-    this->playerCards = new Hand(*anotherPlayer.playerCards);
-    this->playerOrdersList = new OrdersList(*anotherPlayer.playerOrdersList);
+    this->playerCards.reset(new Hand(*anotherPlayer.playerCards));
+    this->playerOrdersList.reset(new OrdersList(*anotherPlayer.playerOrdersList));
     vector<Territory*>temp_Territory = anotherPlayer.territories;
     for (vector<Territory*>::iterator iter = temp_Territory.begin(); iter!=temp_Territory.end(); ++iter){
         Territory* newTerritory = new Territory(**iter);
@@ -73,8 +77,8 @@ Player::Player(const Player &anotherPlayer) {
  * @param name
   */
     Player::Player(string _name, bool _neutral) : name(_name), neutral(_neutral) {
-        playerCards = new Hand();
-        playerOrdersList = new OrdersList();
+        playerCards.reset(new Hand());
+        playerOrdersList.reset(new OrdersList());
     }
 
 /**
@@ -87,14 +91,7 @@ Player::~Player(){
             territory->removeOwner();
         }
     }
-
-    if (playerCards != nullptr) {
-        delete playerCards;
-    }
-
-    if (playerOrdersList != nullptr) {
-        delete playerOrdersList;
-    }
+    // the hand of cards and the orders list are deleted with the player
 }
 
 /**
@@ -118,7 +115,7 @@ string Player::getName() const {
  * @param PlayerCards
  */
 void Player::setPlayerCards(Hand *&PlayerCards) {
-    this->playerCards = PlayerCards;
+    this->playerCards.reset(PlayerCards);
 }
 
 /**
@@ -126,7 +123,7 @@ void Player::setPlayerCards(Hand *&PlayerCards) {
  * @return player hand of cards
  */
 Hand *Player::getPlayerCards() const {
-    return this->playerCards;
+    return this->playerCards.get();
 }
 
 /**
@@ -135,7 +132,7 @@ Hand *Player::getPlayerCards() const {
  */
 
 void Player::setPlayerOrdersList(OrdersList *&ordersList) {
-    this->playerOrdersList = ordersList;
+    this->playerOrdersList.reset(ordersList);
 }
 
 /**
@@ -143,7 +140,7 @@ void Player::setPlayerOrdersList(OrdersList *&ordersList) {
  * @return player orders list
  */
 OrdersList *Player::getPlayerOrdersList()const {
-    return playerOrdersList;
+    return playerOrdersList.get();
 }
 
 /**
@@ -152,6 +149,7 @@ OrdersList *Player::getPlayerOrdersList()const {
  */
 void Player::setTerritories(vector<Territory*> territories) {
     this->territories = territories;
+    forgetQueries();
 }
 
 /**
@@ -167,7 +165,14 @@ vector<Territory*> Player::getTerritories() const {
  * @return list of territories
  */
 vector<Territory*> Player::toDefend() {
-    ps->toDefend(this);
+    if (!isQueryCacheUsable()) {
+        return ps->toDefend(this);
+    }
+    if (!queryCache.hasToDefend) {
+        queryCache.toDefend = ps->toDefend(this);
+        queryCache.hasToDefend = true;
+    }
+    return queryCache.toDefend;
 }
 
 /**
@@ -175,7 +180,36 @@ vector<Territory*> Player::toDefend() {
  * @return list of territories
  */
 vector<Territory*> Player::toAttack() {
-    return ps->toAttack(this);
+    if (!isQueryCacheUsable()) {
+        return ps->toAttack(this);
+    }
+    if (!queryCache.hasToAttack) {
+        queryCache.toAttack = ps->toAttack(this);
+        queryCache.hasToAttack = true;
+    }
+    return queryCache.toAttack;
+}
+
+// the cache is only used for the territories of a map, whose epoch tells when the board changed
+// the cached results are dropped once the board, the strategy or the player's map changed
+bool Player::isQueryCacheUsable() const {
+    Map* map = territories.empty() ? nullptr : territories.front()->getMap();
+    if (map == nullptr || ps == nullptr) {
+        return false;
+    }
+    if (!queryCache.valid || queryCache.map != map || queryCache.epoch != map->getEpoch() || queryCache.strategy != ps) {
+        queryCache = QueryCache();
+        queryCache.valid = true;
+        queryCache.map = map;
+        queryCache.epoch = map->getEpoch();
+        queryCache.strategy = ps;
+    }
+    return true;
+}
+
+// called whenever the list of territories of the player changes
+void Player::forgetQueries() {
+    queryCache.valid = false;
 }
 
 /**
@@ -185,6 +219,13 @@ void Player::issueOrder() {
     return ps->issueOrder(this);
 }
 
+/**
+ * take the territories conquered directly by the strategy
+ */
+void Player::conquer() {
+    ps->conquer(this);
+}
+
 /**
  * defining the assignment operator for player
  * @param anotherPlayer
@@ -192,11 +233,16 @@ void Player::issueOrder() {
  */
 Player &Player::operator=(const Player &anotherPlayer) {
     if (this != & anotherPlayer){
-        this->~Player();
+        for (auto &territory :territories){
+            if(territory != nullptr) {
+                territory->removeOwner();
+            }
+        }
         territories.clear();
+        forgetQueries();
         this->name = anotherPlayer.name +"_copy";
-        this->playerCards = new Hand(*anotherPlayer.playerCards);
-        this->playerOrdersList = new OrdersList(*anotherPlayer.playerOrdersList);
+        this->playerCards.reset(new Hand(*anotherPlayer.playerCards));
+        this->playerOrdersList.reset(new OrdersList(*anotherPlayer.playerOrdersList));
         vector<Territory*>temp_Territory = anotherPlayer.territories;
         for (vector<Territory*>::iterator iter = temp_Territory.begin(); iter!=temp_Territory.end(); ++iter){
             Territory* newTerritory = new Territory(**iter);
@@ -252,6 +298,7 @@ ostream &operator<<(ostream &out, const Player &player) {
  */
 void Player::addTerritory(Territory *newTerritory) {
     this->territories.push_back(newTerritory);
+    forgetQueries();
     newTerritory->setOwner(this);
 }
 
@@ -266,15 +313,57 @@ void Player::removeTerritory(Territory *A_Territory) {
             territories.erase(next(begin(territories), + i));
         }
     }
+    forgetQueries();
 }
+// the lost territories are dropped in a single pass over the list
+void Player::removeTerritories(const vector<Territory*> &lost) {
+    unordered_set<const Territory*> lostSet(lost.begin(), lost.end());
+    territories.erase(remove_if(territories.begin(), territories.end(), [&lostSet](const Territory *territory) {
+        return lostSet.count(territory) > 0;
+    }), territories.end());
+    forgetQueries();
+}
+
+void Player::appendTerritories(const vector<Territory*> &gained) {
+    territories.insert(territories.end(), gained.begin(), gained.end());
+    forgetQueries();
+}
+
 /**
  * move the a territory from one player to another player
  * @param newTerritory
  * @param toTransfer
+ * @param quiet true for a transfer that is not counted, made by an order applied to be taken back
  */
-void Player::transferTerritory(Territory *newTerritory, Player *toTransfer) {
+void Player::transferTerritory(Territory *newTerritory, Player *toTransfer, bool quiet) {
     removeTerritory(newTerritory);
     toTransfer->addTerritory(newTerritory);
+    if (!quiet) {
+        Stats::increment(StatCounter::TERRITORIES_TRANSFERRED);
+    }
+}
+
+// positions out of range put the territory at the end of the list
+void Player::insertTerritory(Territory *territory, int position) {
+    if (position < 0 || position > static_cast<int>(territories.size())) {
+        position = static_cast<int>(territories.size());
+    }
+    territories.insert(territories.begin() + position, territory);
+    forgetQueries();
+    territory->setOwner(this);
+}
+
+int Player::getTerritoryIndex(const Territory *territory) const {
+    auto found = find(territories.begin(), territories.end(), territory);
+    return found != territories.end() ? static_cast<int>(found - territories.begin()) : -1;
+}
+
+size_t Player::getNumTerritories() const {
+    return territories.size();
+}
+
+Territory *Player::getTerritory(size_t index) const {
+    return territories[index];
 }
 
 /**
@@ -282,17 +371,58 @@ void Player::transferTerritory(Territory *newTerritory, Player *toTransfer) {
  * @param player
  */
 void Player::addDiplomaticRelation(Player* player){
+    if (diplomacy != nullptr) {
+        diplomacy->addTruce(this, player);
+        return;
+    }
     diplomaticRelations_.push_back(player);
 }
 
+// the matrix keeps one truce per pair, the list one entry per relation added
+void Player::removeDiplomaticRelation(Player* player, bool hadRelation) {
+    if (diplomacy != nullptr) {
+        if (!hadRelation) {
+            diplomacy->removeTruce(this, player);
+        }
+        return;
+    }
+    auto found = find(diplomaticRelations_.rbegin(), diplomaticRelations_.rend(), player);
+    if (found != diplomaticRelations_.rend()) {
+        diplomaticRelations_.erase(next(found).base());
+    }
+}
+
 /**
  * find player relationships with other players
  * @return
  */
 vector<Player *> Player::getRelations() const {
+    if (diplomacy != nullptr) {
+        return diplomacy->getTruces(this);
+    }
     return diplomaticRelations_;
 }
 
+bool Player::hasDiplomaticRelation(const Player *player) const {
+    if (diplomacy != nullptr) {
+        return diplomacy->hasTruce(this, player);
+    }
+    return find(diplomaticRelations_.begin(), diplomaticRelations_.end(), player) != diplomaticRelations_.end();
+}
+
+void Player::setDiplomacy(DiplomacyMatrix *diplomacy, int diplomacyIndex) {
+    this->diplomacy = diplomacy;
+    this->diplomacyIndex = diplomacyIndex;
+}
+
+DiplomacyMatrix *Player::getDiplomacy() const {
+    return diplomacy;
+}
+
+int Player::getDiplomacyIndex() const {
+    return diplomacyIndex;
+}
+
 /**
  * check if a player represent the system
  * @return true or false
@@ -351,8 +481,8 @@ int Player::getReinforcementPool() const {
     }
 
     Player::Player(string name, strategy playingStrategy) : name(name), neutral(false) {
-        playerCards = new Hand();
-        playerOrdersList = new OrdersList();
+        playerCards.reset(new Hand());
+        playerOrdersList.reset(new OrdersList());
         setStrategy(playingStrategy);
         reinforcement_pool = 0;
     }
@@ -364,11 +494,17 @@ int Player::getReinforcementPool() const {
             }
         }
         territories.clear();
+        forgetQueries();
     }
 
     // Get a list of territories with available armies for moving
+    // reused until the board changes, issuing an order changes the pending armies of its territories
     std::vector<Territory*> Player::getOwnTerritoriesWithMovableArmies() const
     {
+        bool cached = isQueryCacheUsable();
+        if (cached && queryCache.hasMovable) {
+            return queryCache.movable;
+        }
         std::vector<Territory*> territories_;
         for (const auto &territory : territories)
         {
@@ -377,7 +513,10 @@ int Player::getReinforcementPool() const {
                 territories_.push_back(territory);
             }
         }
-
+        if (cached) {
+            queryCache.movable = territories_;
+            queryCache.hasMovable = true;
+        }
         return territories_;
     }
 
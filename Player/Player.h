@@ -5,9 +5,11 @@
 #ifndef COMP345_N11_PLAYER_H
 #define COMP345_N11_PLAYER_H
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <iostream>
+#include <memory>
 using namespace std;
 
 #include "../Map/Map.h"
@@ -15,11 +17,14 @@ using namespace std;
 #include "../Orders/Orders.h"
 #include "../PlayerStrategy/PlayerStrategy.h"
 
+class Map;
 class Territory;
+class PlayerStrategy;
 class Hand;
 class Order;
 class OrdersList;
 class Card;
+class DiplomacyMatrix;
 
 enum strategy:int{
     Aggressive,
@@ -32,12 +37,37 @@ class Player {
 private:
     string name;
     vector<Territory*> territories;
-    Hand *playerCards;
-    OrdersList *playerOrdersList;
-    vector<Player*> diplomaticRelations_;
+    unique_ptr<Hand> playerCards;
+    unique_ptr<OrdersList> playerOrdersList;
+    vector<Player*> diplomaticRelations_; // only used when the player is not part of a game's diplomacy matrix
+    DiplomacyMatrix* diplomacy = nullptr;
+    int diplomacyIndex = -1;
     bool neutral;
     int reinforcement_pool;
     PlayerStrategy* ps;
+
+    // results of the queries of the strategy, reused until the board of the player's map, the territories of the
+    // player or its strategy change
+    struct QueryCache {
+        bool valid = false;
+        const Map* map = nullptr;
+        uint64_t epoch = 0;
+        const PlayerStrategy* strategy = nullptr;
+        bool hasToDefend = false;
+        bool hasToAttack = false;
+        bool hasMovable = false;
+        vector<Territory*> toDefend;
+        vector<Territory*> toAttack;
+        vector<Territory*> movable;
+    };
+    mutable QueryCache queryCache;
+    bool isQueryCacheUsable() const;
+    void forgetQueries();
+
+    // used by Map::transferTerritories, which sets the owners of the territories itself
+    friend class Map;
+    void removeTerritories(const vector<Territory*> &lost);
+    void appendTerritories(const vector<Territory*> &gained);
 public:
     /**
      * default constructor for Player object
@@ -88,7 +118,7 @@ public:
     string getName() const;
 
     /**
-     * add or change player hand of cards
+     * add or change player hand of cards, the player takes ownership of it
      * @param PlayerCards
      */
     void setPlayerCards(Hand *&PlayerCards);
@@ -100,7 +130,7 @@ public:
     Hand* getPlayerCards() const;
 
     /**
-     * add or change player orders list
+     * add or change player orders list, the player takes ownership of it
      * @param ordersList
      */
     void setPlayerOrdersList(OrdersList *&ordersList);
@@ -143,12 +173,14 @@ public:
 
     /**
      * determine player territory(s) that need to be defended
+     * asked to the strategy once per state of the board, see Map::getEpoch
      * @return list of territories
      */
     vector<Territory*> toDefend();
 
     /**
      * determine player territory(s) that need to be attacked
+     * asked to the strategy once per state of the board, see Map::getEpoch
      * @return list of territories
      */
     vector<Territory*> toAttack();
@@ -158,6 +190,10 @@ public:
      */
     void issueOrder();
 
+    /**
+     * takes the territories the strategy of the player conquers directly, outside of any order
+     */
+    void conquer();
 
     /**
      * defining the assignment operator for player
@@ -188,8 +224,27 @@ public:
     /**
      * transfer a territory to player list of territories
      * @param newTerritory
+     * @param quiet true for a transfer that is not counted in the statistics
+     */
+    void transferTerritory (Territory *newTerritory, Player *toTransfer, bool quiet = false);
+
+    /**
+     * put a territory back at a position of the player list of territories, as it was before it was transferred
+     * @param position index in the list, the end of the list if it is out of range
+     */
+    void insertTerritory(Territory *territory, int position);
+
+    /**
+     * @return the index of a territory in the player list of territories, -1 if the player does not own it
+     */
+    int getTerritoryIndex(const Territory *territory) const;
+
+    /**
+     * walk the player list of territories without copying it
+     * @return the number of territories of the player, and the territory at an index of the list
      */
-    void transferTerritory (Territory *newTerritory, Player *toTransfer);
+    size_t getNumTerritories() const;
+    Territory* getTerritory(size_t index) const;
 
     /**
      * Add an enemy player to the list of diplomatic relations for this player
@@ -197,12 +252,29 @@ public:
      */
     void addDiplomaticRelation(Player* player);
 
+    /**
+     * take back the last diplomatic relation added with a player
+     * @param hadRelation whether the players already had a truce before it, which then still holds
+     */
+    void removeDiplomaticRelation(Player* player, bool hadRelation);
+
     /**
      * find the relation between
      * @return
      */
     vector<Player*> getRelations() const;
 
+    /**
+     * whether this player negotiated a truce with another player, O(1) when both are part of the same game
+     * @param player
+     */
+    bool hasDiplomaticRelation(const Player* player) const;
+
+    // set by the diplomacy matrix of the game the player takes part in
+    void setDiplomacy(DiplomacyMatrix* diplomacy, int diplomacyIndex);
+    DiplomacyMatrix* getDiplomacy() const;
+    int getDiplomacyIndex() const;
+
     /**
      * check if a player represent the system
      * @return true or false
@@ -10,6 +10,7 @@ using namespace std;
 #include "../Cards/Cards.h"
 #include "../Map/Map.h"
 #include "../Orders/Orders.h"
+#include "DiplomacyMatrix.h"
 
 void PlayerDriver(){
     /**
@@ -36,12 +37,12 @@ void PlayerDriver(){
     /**
      * creating a hand of cards
      */
-    vector<Card*>cards;
-    cards.push_back(new Card("bomb"));
-    cards.push_back(new Card("reinforcement"));
-    cards.push_back(new Card("blockade"));
-    cards.push_back(new Card("airlift"));
-    cards.push_back(new Card("diplomacy"));
+    vector<Card>cards;
+    cards.push_back(Card("bomb"));
+    cards.push_back(Card("reinforcement"));
+    cards.push_back(Card("blockade"));
+    cards.push_back(Card("airlift"));
+    cards.push_back(Card("diplomacy"));
     Hand * handOfCards = new Hand(cards);
 
 
@@ -138,6 +139,32 @@ void PlayerDriver(){
     cout<<endl;
 
 
+    /**
+     * testing the truces of the diplomacy matrix, which only hold during the turn they were negotiated in
+     */
+    cout <<"\t\t\t***Testing the truces of the Diplomacy Matrix***"<<endl;
+    DiplomacyMatrix diplomacy;
+    diplomacy.registerPlayer(player2);
+    diplomacy.registerPlayer(player3);
+    player2->addDiplomaticRelation(player3);
+    cout << boolalpha;
+    cout << "During the turn of the truce, player No.2 has a truce with player No.3: "
+         << player2->hasDiplomaticRelation(player3) << ", and player No.3 with player No.2: "
+         << player3->hasDiplomaticRelation(player2) << endl;
+    cout << "Player No.2 has a truce with player No.1, who is not in the matrix: "
+         << player2->hasDiplomaticRelation(player1) << endl;
+    diplomacy.nextTurn();
+    cout << "Once the turn of the truce is over, player No.2 has a truce with player No.3: "
+         << player2->hasDiplomaticRelation(player3) << ", and player No.3 with player No.2: "
+         << player3->hasDiplomaticRelation(player2) << endl;
+    cout << "Players having a truce with player No.2: " << diplomacy.getTruces(player2).size() << endl;
+    cout << noboolalpha;
+    // the players outlive the matrix in this driver, they leave it before it is destroyed
+    player2->setDiplomacy(nullptr, -1);
+    player3->setDiplomacy(nullptr, -1);
+    cout<<endl;
+
+
     /**
      * testing toDefend function
      */
@@ -6,9 +6,13 @@
 #include "../Player/Player.h"
 #include <math.h>
 #include "../Orders/Orders.h"
+#include "../Orders/LegalMoves.h"
+#include "../Map/ThreatMap.h"
+#include "../Map/BoardStats.h"
 #include <vector>
 #include <algorithm>
 #include <unordered_set>
+#include <limits>
 using namespace std;
 
 
@@ -41,23 +45,47 @@ vector<Territory*>  BenevolentPlayerStrategy::toAttack(Player *player) {
     return toAttack_Territories;
 }
 
+/**
+ * the territories a benevolent player deploys its reinforcement pool to
+ * territories facing the most enemy armies come first, taken from the map's threat queue in O(log n) each
+ * @param player
+ * @param toDefend_Territories the player's territories ordered from the weakest one, used when there is no map
+ * @return the territories to deploy to, in order
+ */
+static vector<Territory*> benevolentDeployTargets(Player *player, const vector<Territory*> &toDefend_Territories) {
+    // each deploy order takes a third of what is left in the pool, so the number of orders is known up front
+    int numberOfDeployments = 0;
+    for (int pool = player->getReinforcementPool(); pool > 0; pool -= int(ceil(double(pool) / 3))) {
+        numberOfDeployments++;
+    }
+    int numberOfTargets = min(numberOfDeployments, int(toDefend_Territories.size()));
+
+    Map* map = toDefend_Territories.empty() ? nullptr : toDefend_Territories.front()->getMap();
+    if (map == nullptr) {
+        return vector<Territory*>(toDefend_Territories.begin(), toDefend_Territories.begin() + numberOfTargets);
+    }
+    return map->getThreatMap()->mostThreatened(player, numberOfTargets);
+}
+
 /**
  * issue order will go through all benevolent player territories to add armies to the the ones with least number of armies
  * @param player
  */
 void BenevolentPlayerStrategy::issueOrder(Player *player)  {
-    vector<Territory*>toDefend_Territories = toDefend(player);
+    vector<Territory*>toDefend_Territories = player->toDefend();
 //    for (auto &ter: toDefend_Territories){
 //        cout<<*ter<<endl;
 //    }
-    // using all the reinforcement armies for territories that do not have enough armies to protect itself
-    while (player->getReinforcementPool()>0){
-        for (auto &territory : toDefend_Territories){
+    // using all the reinforcement armies for territories that are the most exposed to enemy armies
+    vector<Territory*> deployTargets = benevolentDeployTargets(player, toDefend_Territories);
+    while (player->getReinforcementPool()>0 && !deployTargets.empty()){
+        for (auto &territory : deployTargets){
             int playerArmies = player->getReinforcementPool();
             if (playerArmies > 0 ) {
                 int armies = ceil(double(playerArmies) / 3);
+                // the deploys to a territory already deployed to add up to a single order
                 DeployOrder *deployOrder = new DeployOrder(player, armies, territory);
-                player->getPlayerOrdersList()->add(deployOrder);
+                player->getPlayerOrdersList()->add(deployOrder, true);
                 player->setReinforcementPool(playerArmies - armies);
             }
         }
@@ -80,12 +108,10 @@ void BenevolentPlayerStrategy::issueOrder(Player *player)  {
         //  if there is no enough armies in the reinforcement pool use Card to issue order
         // to protect the territories with the lowest number of armies
         if (i == territory->getNumAdjTerritories() && territory->getNumberOfArmies()<4){
-            for (auto &card: player->getPlayerCards()->getHand()) {
-                if (card!= nullptr && card->getType() == "Airlift") {
-                    card->useCardtoCreateOrder(player,2, toDefend_Territories.at(j),territory);
-                    player->getPlayerCards()->removeCard(card);
-                    j--;
-                }
+            while (j >= 0 && player->getPlayerCards()->hasCard(CardType::Airlift)) {
+                Card(CardType::Airlift).useCardtoCreateOrder(player,2, toDefend_Territories.at(j),territory);
+                player->getPlayerCards()->removeCard(CardType::Airlift);
+                j--;
             }
         }
     }
@@ -151,6 +177,35 @@ vector<Territory *> HumanPlayerStrategy::toAttack(Player *player) {
     }
     return territoriesToAttack;
 }
+// reads the territory a human player picks among the options listed, either by its number in the list or by its name
+// returns nullptr if the input is none of the options
+Territory* readTerritorySelection(const std::vector<Territory*> &options){
+    std::string selection;
+    std::cin >> selection;
+    if (std::cin.fail() || options.empty())
+    {
+        std::cin.clear();
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        return nullptr;
+    }
+
+    if (selection.length() < 10 && all_of(selection.begin(), selection.end(), [](char c) { return ::isdigit(static_cast<unsigned char>(c)) != 0; }))
+    {
+        int number = stoi(selection);
+        return number >= 1 && number <= static_cast<int>(options.size()) ? options.at(number - 1) : nullptr;
+    }
+
+    // the name index of the map finds the territory without comparing the name with every option
+    Map* map = options.front()->getMap();
+    Territory* named = map != nullptr ? map->findTerritory(selection) : nullptr;
+    if (named == nullptr || find(options.begin(), options.end(), named) == options.end())
+    {
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        return nullptr;
+    }
+    return named;
+}
+
 Territory* showOwnedTerritoriesForInput(Player* player){
     std::vector<Territory*> possibleSources = player->getOwnTerritoriesWithMovableArmies();
 
@@ -162,21 +217,14 @@ Territory* showOwnedTerritoriesForInput(Player* player){
     }
 
     Territory* source = nullptr;
-    std::cout << "\nEnter the territory to advance from: ";
+    std::cout << "\nEnter the number or the name of the territory to advance from: ";
     while (source == nullptr)
     {
-        int selection;
-        std::cin >> selection;
-
-        if (std::cin.fail() || selection - 1 < 0 )
+        source = readTerritorySelection(possibleSources);
+        if (source == nullptr)
         {
             std::cout << "That was not a valid option. Please try again:" << std::endl;
-            std::cin.clear();
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-            continue;
         }
-
-        source = possibleSources.at(selection - 1);
     }
     return source;
 }
@@ -205,28 +253,16 @@ Territory* showAdjTerritoriesForInput(Territory* source){
         }
     }
 
+    std::vector<Territory*> options(defendable);
+    options.insert(options.end(), adjTerritories.begin(), adjTerritories.end());
     Territory* destination = nullptr;
-    std::cout << "\nEnter the territory to advance to: ";
+    std::cout << "\nEnter the number or the name of the territory to advance to: ";
     while (destination == nullptr)
     {
-        int selection;
-        std::cin >> selection;
-
-        if (std::cin.fail() || selection - 1 < 0 || selection - 1 >= defendable.size() + adjTerritories.size())
+        destination = readTerritorySelection(options);
+        if (destination == nullptr)
         {
             std::cout << "That was not a valid option. Please try again:" << std::endl;
-            std::cin.clear();
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-            continue;
-        }
-
-        if (selection <= defendable.size())
-        {
-            destination = defendable.at(selection - 1);
-        }
-        else
-        {
-            destination = adjTerritories.at(selection - 1 - defendable.size());
         }
     }
     return destination;
@@ -265,7 +301,7 @@ bool HumanPlayerStrategy::playCard_(Player* player)
 
 
 
-    player->getPlayerCards()->getHand().at(0)->useCardtoCreateOrder(player , army, source, destination);
+    player->getPlayerCards()->getHand().at(0).useCardtoCreateOrder(player , army, source, destination);
     OrdersList* ordersList = player->getPlayerOrdersList();
     for (auto &order: ordersList->getOrders()){
         order->execute();
@@ -280,10 +316,6 @@ bool HumanPlayerStrategy::playCard_(Player* player)
 }
 
 void HumanPlayerStrategy::issueOrder(Player *player)  {
-    std::vector<Territory*> territoriesToAttack = toAttack(player);
-    std::vector<Territory*> territoriesToDefend = toDefend(player);
-
-
     if (player->getOwnTerritoriesWithMovableArmies().size() > 0)
     {
 
@@ -305,12 +337,12 @@ void HumanPlayerStrategy::issueOrder(Player *player)  {
 
         if (selection == "A")
         {
-            issueAdvance_(player, territoriesToDefend);
+            issueAdvance_(player);
             break;
         }
         else if (selection == "D")
         {
-            deployReinforcements_(player, territoriesToDefend);
+            deployReinforcements_(player);
             break;
         }
         else if (selection == "C")
@@ -325,9 +357,24 @@ void HumanPlayerStrategy::issueOrder(Player *player)  {
 }
 
 // Issue an advance order to either fortify or attack a territory
-void HumanPlayerStrategy::issueAdvance_(Player* player, std::vector<Territory*> territoriesToDefend)
+// the sources and destinations offered are the legal advances of the player
+void HumanPlayerStrategy::issueAdvance_(Player* player)
 {
-    std::vector<Territory*> possibleSources = player->getOwnTerritoriesWithMovableArmies();
+    std::vector<Territory*> possibleSources;
+    LegalMoves advances(player, 1u << ADVANCE);
+    LegalMove move;
+    while (advances.next(move))
+    {
+        if (possibleSources.empty() || possibleSources.back() != move.source)
+        {
+            possibleSources.push_back(move.source);
+        }
+    }
+    if (possibleSources.empty())
+    {
+        std::cout << "There is no territory to advance from." << std::endl;
+        return;
+    }
 
     std::cout << "\nWhich territory would you like to advance from?" << std::endl;
     for (int i = 0; i < possibleSources.size(); i++)
@@ -337,36 +384,30 @@ void HumanPlayerStrategy::issueAdvance_(Player* player, std::vector<Territory*>
     }
 
     Territory* source = nullptr;
-    std::cout << "\nEnter the territory to advance from: ";
+    std::cout << "\nEnter the number or the name of the territory to advance from: ";
     while (source == nullptr)
     {
-        int selection;
-        std::cin >> selection;
-
-        if (std::cin.fail() || selection - 1 < 0 )
+        source = readTerritorySelection(possibleSources);
+        if (source == nullptr)
         {
             std::cout << "That was not a valid option. Please try again:" << std::endl;
-            std::cin.clear();
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-            continue;
         }
-
-        source = possibleSources.at(selection - 1);
     }
 
     // Display adjacent territories as either attackable or defendable
     std::vector<Territory*> attackable;
     std::vector<Territory*> defendable;
-    int index=0;
-    for(;index<source->getNumAdjTerritories();index++){
-        Territory* territory = source->getAdjTerritories()[index];
-        if (find(territoriesToDefend.begin(), territoriesToDefend.end(), territory) != territoriesToDefend.end())
+    LegalMoves destinations(player, 1u << ADVANCE);
+    destinations.from(source);
+    while (destinations.next(move))
+    {
+        if (move.destination->getOwner() == player)
         {
-            defendable.push_back(source->getAdjTerritories()[index]);
+            defendable.push_back(move.destination);
         }
         else
         {
-            attackable.push_back(source->getAdjTerritories()[index]);
+            attackable.push_back(move.destination);
         }
     }
 
@@ -394,28 +435,16 @@ void HumanPlayerStrategy::issueAdvance_(Player* player, std::vector<Territory*>
         }
     }
 
+    std::vector<Territory*> options(defendable);
+    options.insert(options.end(), attackable.begin(), attackable.end());
     Territory* destination = nullptr;
-    std::cout << "\nEnter the territory to advance to: ";
+    std::cout << "\nEnter the number or the name of the territory to advance to: ";
     while (destination == nullptr)
     {
-        int selection;
-        std::cin >> selection;
-
-        if (std::cin.fail() || selection - 1 < 0 || selection - 1 >= defendable.size() + attackable.size())
+        destination = readTerritorySelection(options);
+        if (destination == nullptr)
         {
             std::cout << "That was not a valid option. Please try again:" << std::endl;
-            std::cin.clear();
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-            continue;
-        }
-
-        if (selection <= defendable.size())
-        {
-            destination = defendable.at(selection - 1);
-        }
-        else
-        {
-            destination = attackable.at(selection - 1 - defendable.size());
         }
     }
 
@@ -447,9 +476,21 @@ void HumanPlayerStrategy::issueAdvance_(Player* player, std::vector<Territory*>
 }
 
 // Deploy player's reinforcements to specified territory
-void HumanPlayerStrategy::deployReinforcements_(Player* player, std::vector<Territory*> territoriesToDefend)
+// the territories offered are the legal deploys of the player
+void HumanPlayerStrategy::deployReinforcements_(Player* player)
 {
+    std::vector<Territory*> territoriesToDefend;
+    LegalMoves deploys(player, 1u << DEPLOY);
+    LegalMove move;
+    while (deploys.next(move))
+    {
+        territoriesToDefend.push_back(move.destination);
+    }
     std::cout << "You have " << player->getReinforcementPool() << " reinforcements left." << std::endl;
+    if (territoriesToDefend.empty())
+    {
+        return;
+    }
     std::cout << "\nWhere would you like to deploy to?" << std::endl;
     for (int i = 0; i < territoriesToDefend.size(); i++)
     {
@@ -458,21 +499,14 @@ void HumanPlayerStrategy::deployReinforcements_(Player* player, std::vector<Terr
     }
 
     Territory* deployTarget = nullptr;
-    std::cout << "\nEnter the territory to deploy to: ";
+    std::cout << "\nEnter the number or the name of the territory to deploy to: ";
     while (deployTarget == nullptr)
     {
-        int selection;
-        std::cin >> selection;
-
-        if (std::cin.fail() || selection - 1 < 0 || selection - 1 >= territoriesToDefend.size())
+        deployTarget = readTerritorySelection(territoriesToDefend);
+        if (deployTarget == nullptr)
         {
             std::cout << "That was not a valid option. Please try again:" << std::endl;
-            std::cin.clear();
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-            continue;
         }
-
-        deployTarget = territoriesToDefend.at(selection - 1);
     }
 
     int armiesToDeploy = 0;
@@ -517,29 +551,33 @@ vector<Territory *> AggressivePlayerStrategy::toDefend(Player *player) {
     return territoriesToDefend;
 }
 
-// return a vector that has the player's strongest territory
+// return a vector that has the player's strongest territory, empty for a player without territories
+// taken from the statistics of the board when the player is on a map, in a single pass over its territories otherwise
 vector<Territory *> AggressivePlayerStrategy::toAttack(Player *player) {
-    std::vector<Territory*> sources = toDefend(player);
-    std::vector<Territory*> territoriesToAttack;
-    std::unordered_set<Territory*> territoriesSeen;
-
-    Territory* strongest;
-    int strongestArmy = 0;
-    for (const auto &territory : sources)
+    std::vector<Territory*> territories = player->getTerritories();
+    if (territories.empty()) {
+        return {};
+    }
+    Map* map = territories.front()->getMap();
+    if (map != nullptr) {
+        return {map->getBoardStats()->of(player).strongest};
+    }
+    Territory* strongest = territories.front();
+    for (const auto &territory : territories)
     {
-        if (territory->getNumberOfArmies()>=strongestArmy){
-            strongestArmy= territory->getNumberOfArmies();
+        if (territory->getNumberOfArmies() > strongest->getNumberOfArmies()){
             strongest = territory;
         }
     }
-    territoriesToAttack.push_back(strongest);
-
-    return territoriesToAttack;
+    return {strongest};
 }
 
 void AggressivePlayerStrategy::issueOrder(Player *player)  {
 
-    std::vector<Territory*> territoriesToAttack = toAttack(player);
+    std::vector<Territory*> territoriesToAttack = player->toAttack();
+    if (territoriesToAttack.empty()) {
+        return;
+    }
     Territory* strongest = territoriesToAttack.at(0);
 
     for (int i =0; i<strongest->getNumAdjTerritories(); i++){
@@ -588,24 +626,49 @@ vector<Territory *> CheaterPlayerStrategy::toAttack(Player *player) {
 }
 
 /**
- * issue order method will go through every adjacent territory and issue an Advance Order with 10x
- * the amount of army inside that territory -> guarantee conquer
+ * issue order method does not issue anything for Cheater, its territories are taken in the execution phase
  * @param player
  */
 void CheaterPlayerStrategy::issueOrder(Player *player) {
+    cout << player->getName() << " will conquer the territories adjacent to its own." << endl;
+}
+
+/**
+ * conquer method takes every enemy territory adjacent to the territories of the player at once, except those of the
+ * players it negotiated a truce with; the armies on the conquered territories are kept.
+ * It runs once every order of the turn is executed, so the armies deployed by the other players stay on their
+ * territories and the truces negotiated during the turn are respected.
+ * @param player
+ */
+void CheaterPlayerStrategy::conquer(Player *player) {
     vector<Territory *> territories_of_this_player = toAttack(player);
+    if (territories_of_this_player.empty()) {
+        return;
+    }
+    vector<Territory *> conquered;
+    unordered_set<Territory *> seen;
     for (auto &territory : territories_of_this_player){
         Territory** adjTerritories = territory->getAdjTerritories();
         for (int i = 0; i<territory->getNumAdjTerritories(); i++){
-            int armyToAttack = (adjTerritories[i]->getNumberOfArmies()*2);
-            if (armyToAttack == 0 || armyToAttack >50) {
-                armyToAttack =20;
+            Territory* adjTerritory = adjTerritories[i];
+            Player* owner = adjTerritory != nullptr ? adjTerritory->getOwner() : nullptr;
+            if (owner == nullptr || owner == player || player->hasDiplomaticRelation(owner) || !seen.insert(adjTerritory).second) {
+                continue;
             }
-            AdvanceOrder *advanceOrder = new AdvanceOrder(player, armyToAttack, territory, adjTerritories[i]);
-            player->getPlayerOrdersList()->add(advanceOrder);
-            player->setReinforcementPool(player->getReinforcementPool()+armyToAttack);
+            if (owner->getStrategy() == GameEngine::strategyType.at(strategy::Neutral)) {
+                cout<<"**" << endl;
+                cout<< "STRATEGY CHANGE: an attack happen to one of the neutral player territories....Now neutral player becomes aggressive player"<<endl;
+                cout<<"**" << endl;
+                owner->setStrategy(strategy::Aggressive);
+            }
+            conquered.push_back(adjTerritory);
         }
     }
+    if (conquered.empty()) {
+        return;
+    }
+    territories_of_this_player.front()->getMap()->transferTerritories(conquered, player);
+    cout << player->getName() << " conquered " << conquered.size() << " adjacent territory(ies)." << endl;
 }
 
 void CheaterPlayerStrategy::print(Player *player) {
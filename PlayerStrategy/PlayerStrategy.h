@@ -18,6 +18,11 @@ public:
     virtual vector<Territory*>  toAttack(Player *player) = 0;
     virtual void issueOrder(Player *player) = 0;
     virtual void print(Player *player)=0;
+    /**
+     * takes territories directly, outside of any order, once every order of the turn is executed;
+     * the strategies that only issue orders take nothing
+     */
+    virtual void conquer(Player *player) {}
 // NOTE: no copy, assignment operators for PlayerStrategy as it doesn't have any attribute
 // does not make sense to have those methods
 
@@ -33,9 +38,9 @@ public:
     virtual void print(Player *player);
     friend ostream &operator<<(ostream &out, const HumanPlayerStrategy &ps);
 private:
-    void deployReinforcements_(Player *player, std::vector<Territory *> territoriesToDefend);
+    void deployReinforcements_(Player *player);
 
-    void issueAdvance_(Player *player, std::vector<Territory *> territoriesToDefend);
+    void issueAdvance_(Player *player);
     bool playCard_(Player* player);
 };
 
@@ -72,6 +77,7 @@ public:
     virtual vector<Territory*> toDefend(Player *player);
     virtual vector<Territory*> toAttack(Player *player);
     virtual void issueOrder(Player *player);
+    virtual void conquer(Player *player);
     virtual void print(Player *player);
     friend ostream &operator<<(ostream &out, const CheaterPlayerStrategy &ps);
 };
@@ -0,0 +1,106 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#ifndef COMP345_N11_BINARYIO_H
+#define COMP345_N11_BINARYIO_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+using namespace std;
+
+const uint64_t FNV_OFFSET = 14695981039346656037ULL;
+const uint64_t FNV_PRIME = 1099511628211ULL;
+
+/**
+ * 64-bit FNV-1a hash of some bytes, chained by passing the hash of the previous bytes
+ */
+inline uint64_t fnv1a(const void *bytes, size_t length, uint64_t hash = FNV_OFFSET) {
+    const unsigned char *data = static_cast<const unsigned char*>(bytes);
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ data[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * Appends fixed size values and strings to a buffer, in the byte order of the machine.
+ * Used by the binary files of the game: game records and tournament checkpoints.
+ */
+class BinaryWriter {
+public:
+    template <typename T>
+    void write(const T &value) {
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void writeBytes(const void *bytes, size_t length) {
+        buffer.append(static_cast<const char*>(bytes), length);
+    }
+
+    void writeString(const string &value) {
+        write(static_cast<uint32_t>(value.size()));
+        buffer.append(value);
+    }
+
+    const string &getBuffer() const {
+        return buffer;
+    }
+
+    void clear() {
+        buffer.clear();
+    }
+
+private:
+    string buffer;
+};
+
+/**
+ * Reads back what a BinaryWriter wrote, failing instead of reading past the end of the data.
+ * The reader keeps a reference to the data, which must outlive it.
+ */
+class BinaryReader {
+public:
+    explicit BinaryReader(const string &data) : data(data), position(0) {}
+
+    template <typename T>
+    bool read(T &value) {
+        return readBytes(&value, sizeof(T));
+    }
+
+    bool readBytes(void *bytes, size_t length) {
+        if (length > remaining()) {
+            return false;
+        }
+        if (length > 0) {
+            memcpy(bytes, data.data() + position, length);
+        }
+        position += length;
+        return true;
+    }
+
+    bool readString(string &value) {
+        uint32_t length;
+        if (!read(length) || length > remaining()) {
+            return false;
+        }
+        value.assign(data, position, length);
+        position += length;
+        return true;
+    }
+
+    size_t remaining() const {
+        return data.size() - position;
+    }
+
+    size_t getPosition() const {
+        return position;
+    }
+
+private:
+    const string &data;
+    size_t position;
+};
+
+#endif //COMP345_N11_BINARYIO_H
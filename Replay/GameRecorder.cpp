@@ -0,0 +1,164 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "GameRecorder.h"
+#include "../GameEngine/GameEngine.h"
+#include "../Orders/Orders.h"
+#include "BinaryIO.h"
+#include <algorithm>
+
+namespace {
+    void hashInt(uint64_t &hash, int32_t value) {
+        hash = fnv1a(&value, sizeof(value), hash);
+    }
+
+    void hashString(uint64_t &hash, const string &value) {
+        hashInt(hash, static_cast<int32_t>(value.size()));
+        hash = fnv1a(value.data(), value.size(), hash);
+    }
+
+    uint8_t strategyIndexOf(const Player *player) {
+        int strategyIndex = GameEngine::getStrategyIndex(player);
+        return strategyIndex < 0 ? GameRecordFormat::NO_PLAYER : static_cast<uint8_t>(strategyIndex);
+    }
+}
+
+uint64_t GameRecordFormat::fingerprint(Map *map) {
+    uint64_t hash = FNV_OFFSET;
+    hashInt(hash, map->getNumTerritories());
+    for (int i = 0; i < map->getNumTerritories(); i++) {
+        Territory *territory = map->getTerritories()[i];
+        hashInt(hash, territory->getId());
+        hashString(hash, territory->getName());
+        hashString(hash, territory->getContinent() != nullptr ? territory->getContinent()->getName() : "");
+        hashInt(hash, territory->getNumAdjTerritories());
+        for (int j = 0; j < territory->getNumAdjTerritories(); j++) {
+            hashInt(hash, territory->getAdjTerritories()[j]->getId());
+        }
+    }
+    return hash;
+}
+
+GameRecorder::GameRecorder(const string &fileName, unsigned seed, Map *map, const string &mapFileName,
+                           const vector<Player*> &players, uint32_t snapshotInterval)
+        : fileName(fileName), file(fileName, ios::binary | ios::trunc), map(map), players(players),
+          snapshotInterval(max(snapshotInterval, 1u)), turn(0), executingOrders(false), start(chrono::steady_clock::now()) {
+    if (!file.is_open()) {
+        return;
+    }
+    BinaryWriter writer;
+    writer.writeBytes(GameRecordFormat::MAGIC, sizeof(GameRecordFormat::MAGIC));
+    writer.write(GameRecordFormat::VERSION);
+    writer.write(static_cast<uint32_t>(seed));
+    writer.write(GameRecordFormat::fingerprint(map));
+    writer.writeString(mapFileName);
+    writer.write(static_cast<uint32_t>(map->getNumTerritories()));
+    writer.write(this->snapshotInterval);
+    writer.write(static_cast<uint8_t>(players.size()));
+    for (auto &player : players) {
+        writer.writeString(player->getName());
+    }
+    writeSnapshot(writer);
+    flush(writer);
+}
+
+GameRecorder::~GameRecorder() {
+    if (file.is_open()) {
+        file.close();
+    }
+}
+
+bool GameRecorder::isOpen() const {
+    return file.is_open();
+}
+
+const string &GameRecorder::getFileName() const {
+    return fileName;
+}
+
+// players are few, a linear search is the fastest way to find them
+uint8_t GameRecorder::indexOf(const Player *player) const {
+    return OrderKernel::indexOf(players, player);
+}
+
+void GameRecorder::beginTurn() {
+    turn++;
+    executingOrders = false;
+    turnOrders.clear();
+}
+
+// called just before the engine executes an order
+void GameRecorder::recordOrder(const Order *order) {
+    executingOrders = true;
+    turnOrders.push_back(order->encode(players));
+}
+
+void GameRecorder::beginTransfers() {
+    executingOrders = false;
+}
+
+// one record per territory, a transfer being replayed as the conquests of the territories in a row
+void GameRecorder::territoriesTransferred(const vector<Territory*> &territories, Player *newOwner) {
+    if (executingOrders) {
+        return;
+    }
+    for (auto &territory : territories) {
+        turnOrders.push_back({GameRecordFormat::TRANSFER, indexOf(newOwner), GameRecordFormat::NO_PLAYER, 0, 0,
+                              territory->getId(), 0});
+    }
+}
+
+// the orders of a turn are written at once, after the strategies the players had when the turn started
+void GameRecorder::endTurn() {
+    if (!file.is_open()) {
+        return;
+    }
+    BinaryWriter writer;
+    writer.write(GameRecordFormat::TURN_TAG);
+    writer.write(turn);
+    for (auto &player : players) {
+        writer.write(strategyIndexOf(player));
+    }
+    writer.write(static_cast<uint32_t>(turnOrders.size()));
+    writer.writeBytes(turnOrders.data(), turnOrders.size() * sizeof(OrderRecord));
+    turnOrders.clear();
+    if (turn % snapshotInterval == 0) {
+        writeSnapshot(writer);
+    }
+    flush(writer);
+}
+
+void GameRecorder::finish(Player *winner) {
+    if (!file.is_open()) {
+        return;
+    }
+    BinaryWriter writer;
+    if (turn % snapshotInterval != 0) {
+        writeSnapshot(writer);
+    }
+    writer.write(GameRecordFormat::END_TAG);
+    writer.write(turn);
+    writer.write(winner != nullptr ? indexOf(winner) : GameRecordFormat::NO_PLAYER);
+    writer.write(static_cast<int64_t>(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count()));
+    flush(writer);
+    file.close();
+}
+
+// owner and armies of every territory, in the order of the territories of the map
+void GameRecorder::writeSnapshot(BinaryWriter &writer) {
+    writer.write(GameRecordFormat::SNAPSHOT_TAG);
+    writer.write(turn);
+    int numTerritories = map->getNumTerritories();
+    for (int i = 0; i < numTerritories; i++) {
+        writer.write(indexOf(map->getTerritories()[i]->getOwner()));
+    }
+    for (int i = 0; i < numTerritories; i++) {
+        writer.write(static_cast<int32_t>(map->getTerritories()[i]->getNumberOfArmies()));
+    }
+}
+
+// blocks are built in memory and written at once
+void GameRecorder::flush(const BinaryWriter &writer) {
+    file.write(writer.getBuffer().data(), writer.getBuffer().size());
+}
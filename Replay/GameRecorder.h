@@ -0,0 +1,106 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#ifndef COMP345_N11_GAMERECORDER_H
+#define COMP345_N11_GAMERECORDER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <chrono>
+#include "../Map/Map.h"
+#include "../Orders/OrderKernel.h"
+using namespace std;
+
+class Player;
+class Order;
+class BinaryWriter;
+
+/**
+ * Layout of the game record files.
+ * The orders and the territories conquered directly by a player (TRANSFER type) are written as OrderRecords, whose
+ * players are indexes in the record, 0 being the neutral player.
+ * A header (seed, map, players) is followed by tagged blocks: the orders executed during a turn together with the
+ * strategies the players had when the turn started, snapshots of the board taken every few turns, and an end block.
+ * Integers are written in the byte order of the machine.
+ */
+namespace GameRecordFormat {
+    const char MAGIC[4] = {'W', 'Z', 'R', 'C'};
+    const uint32_t VERSION = 2;
+    const uint8_t TURN_TAG = 'T';
+    const uint8_t SNAPSHOT_TAG = 'S';
+    const uint8_t END_TAG = 'E';
+    const uint8_t TRANSFER = 0x80; //type of the records of the territories handed over outside of any order
+    const uint8_t NO_PLAYER = OrderKernel::NO_PLAYER; //owner of an unowned territory, winner of a draw, strategy of the neutral player
+    const uint32_t DEFAULT_SNAPSHOT_INTERVAL = 10;
+
+    /**
+     * hash of the territories, continents and borders of a map, so a record is never replayed on another map
+     */
+    uint64_t fingerprint(Map *map);
+}
+
+/**
+ * Writes the game record of one game: the seed, the identity of the map and every order executed by the engine,
+ * so the game can be replayed later by GameReplay without running any player strategy.
+ * The territories a strategy takes directly outside of any order, as the cheater does, are recorded as transfers
+ * once the recorder listens to the transfers of the map.
+ */
+class GameRecorder : public TransferListener {
+public:
+    /**
+     * opens the record and writes its header and the snapshot of the initial board
+     * @param players the neutral player followed by the players of the game
+     */
+    GameRecorder(const string &fileName, unsigned seed, Map *map, const string &mapFileName,
+                 const vector<Player*> &players, uint32_t snapshotInterval = GameRecordFormat::DEFAULT_SNAPSHOT_INTERVAL);
+    GameRecorder(const GameRecorder &anotherRecorder) = delete;
+    GameRecorder& operator = (const GameRecorder &anotherRecorder) = delete;
+    ~GameRecorder() override;
+
+    bool isOpen() const;
+    const string &getFileName() const;
+
+    /**
+     * starts the record of a turn, before the players issue their orders
+     */
+    void beginTurn();
+    void recordOrder(const Order *order);
+    void endTurn();
+
+    /**
+     * the territories handed over from now on until the next order is recorded are taken outside of any order
+     */
+    void beginTransfers();
+
+    /**
+     * records the territories handed over outside of any order, before the first order of the turn or after
+     * beginTransfers; the transfers made by the orders themselves are replayed with the orders
+     */
+    void territoriesTransferred(const vector<Territory*> &territories, Player *newOwner) override;
+
+    /**
+     * writes the final snapshot and the end block, then closes the record
+     * @param winner the winner of the game, nullptr for a draw
+     */
+    void finish(Player *winner);
+
+private:
+    string fileName;
+    ofstream file;
+    Map *map;
+    vector<Player*> players;
+    uint32_t snapshotInterval;
+    uint32_t turn;
+    bool executingOrders;
+    vector<OrderRecord> turnOrders;
+    chrono::steady_clock::time_point start;
+
+    uint8_t indexOf(const Player *player) const;
+    void writeSnapshot(BinaryWriter &writer);
+    void flush(const BinaryWriter &writer);
+};
+
+#endif //COMP345_N11_GAMERECORDER_H
@@ -0,0 +1,330 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "GameReplay.h"
+#include "../GameEngine/GameEngine.h"
+#include "../Orders/Orders.h"
+#include "BinaryIO.h"
+#include <cstring>
+#include <iterator>
+
+namespace {
+    // the orders print every step of their execution, a replay discards it
+    class SilentOutput {
+    public:
+        SilentOutput() : saved(cout.rdbuf(nullptr)) {}
+        ~SilentOutput() {
+            cout.rdbuf(saved);
+            cout.clear();
+        }
+    private:
+        streambuf *saved;
+    };
+}
+
+GameReplay::GameReplay() : seed(0), map(nullptr), winner(GameRecordFormat::NO_PLAYER), recordedNanoseconds(0),
+                           turn(0), numOrdersReplayed(0) {}
+
+GameReplay::~GameReplay() {
+    clear();
+}
+
+// gives the territories of the map back before deleting it, the neutral player outlives the replay
+void GameReplay::clear() {
+    if (map != nullptr) {
+        for (int i = 0; i < map->getNumTerritories(); i++) {
+            Territory *territory = map->getTerritories()[i];
+            if (territory->getOwner() != nullptr) {
+                territory->getOwner()->removeTerritory(territory);
+            }
+        }
+    }
+    for (size_t i = 1; i < players.size(); i++) {
+        delete players[i];
+    }
+    players.clear();
+    if (map != nullptr) {
+        delete map;
+        map = nullptr;
+    }
+    turns.clear();
+    orders.clear();
+    snapshots.clear();
+    mapFileName.clear();
+    seed = 0;
+    winner = GameRecordFormat::NO_PLAYER;
+    recordedNanoseconds = 0;
+    turn = 0;
+    numOrdersReplayed = 0;
+}
+
+bool GameReplay::load(const string &fileName) {
+    clear();
+    ifstream file(fileName, ios::binary);
+    if (!file.is_open()) {
+        cout << "Unable to open the game record " << fileName << endl;
+        return false;
+    }
+    string data((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+    BinaryReader reader(data);
+
+    // header
+    char magic[sizeof(GameRecordFormat::MAGIC)];
+    uint32_t version, seed32, numTerritories, snapshotInterval;
+    uint64_t fingerprint;
+    uint8_t numPlayers;
+    if (!reader.readBytes(magic, sizeof(magic)) || memcmp(magic, GameRecordFormat::MAGIC, sizeof(magic)) != 0 ||
+        !reader.read(version) || version != GameRecordFormat::VERSION) {
+        cout << fileName << " is not a game record of this version of the game" << endl;
+        return false;
+    }
+    vector<string> names;
+    bool validHeader = reader.read(seed32) && reader.read(fingerprint) && reader.readString(mapFileName) &&
+                       reader.read(numTerritories) && reader.read(snapshotInterval) && reader.read(numPlayers) &&
+                       numPlayers > 0 && numPlayers != GameRecordFormat::NO_PLAYER;
+    for (int i = 0; validHeader && i < numPlayers; i++) {
+        string name;
+        validHeader = reader.readString(name);
+        names.push_back(name);
+    }
+    if (!validHeader) {
+        cout << "The header of the game record " << fileName << " is corrupted" << endl;
+        clear();
+        return false;
+    }
+    seed = seed32;
+
+    map = MapLoader::loadMapFile(mapFileName);
+    if (map->getNumTerritories() != static_cast<int>(numTerritories) || GameRecordFormat::fingerprint(map) != fingerprint) {
+        cout << "The map " << mapFileName << " is missing or changed since the game was recorded" << endl;
+        clear();
+        return false;
+    }
+    players.push_back(GameEngine::getNeutralPlayer());
+    for (int i = 1; i < numPlayers; i++) {
+        players.push_back(new Player(names[i], Neutral));
+    }
+
+    // blocks, a record cut short by a crash is replayed up to its last complete block
+    bool corrupted = false;
+    uint8_t tag;
+    while (!corrupted && reader.read(tag)) {
+        if (tag == GameRecordFormat::TURN_TAG) {
+            uint32_t number, numOrders;
+            TurnRecord record;
+            record.strategies.resize(numPlayers);
+            if (!reader.read(number) || !reader.readBytes(record.strategies.data(), numPlayers) ||
+                !reader.read(numOrders) || numOrders > reader.remaining() / sizeof(OrderRecord)) {
+                break;
+            }
+            corrupted = number != turns.size() + 1;
+            record.firstOrder = orders.size();
+            record.numOrders = numOrders;
+            orders.resize(record.firstOrder + numOrders);
+            reader.readBytes(orders.data() + record.firstOrder, numOrders * sizeof(OrderRecord));
+            for (size_t i = record.firstOrder; i < orders.size(); i++) {
+                const OrderRecord &order = orders[i];
+                bool withSource = order.type == ADVANCE || order.type == AIRLIFT;
+                bool withDestination = order.type != NEGOTIATE;
+                corrupted = corrupted || (order.type > NEGOTIATE && order.type != GameRecordFormat::TRANSFER) || order.issuer >= numPlayers ||
+                            (order.type == NEGOTIATE && order.target >= numPlayers) ||
+                            (withSource && (order.source < 1 || order.source > static_cast<int32_t>(numTerritories))) ||
+                            (withDestination && (order.destination < 1 || order.destination > static_cast<int32_t>(numTerritories)));
+            }
+            turns.push_back(record);
+        } else if (tag == GameRecordFormat::SNAPSHOT_TAG) {
+            uint32_t number;
+            Snapshot snapshot;
+            snapshot.owners.resize(numTerritories);
+            snapshot.armies.resize(numTerritories);
+            if (!reader.read(number) || !reader.readBytes(snapshot.owners.data(), numTerritories) ||
+                !reader.readBytes(snapshot.armies.data(), numTerritories * sizeof(int32_t))) {
+                break;
+            }
+            snapshot.turn = static_cast<int>(number);
+            corrupted = number != turns.size();
+            for (auto owner : snapshot.owners) {
+                corrupted = corrupted || (owner >= numPlayers && owner != GameRecordFormat::NO_PLAYER);
+            }
+            snapshots.push_back(snapshot);
+        } else if (tag == GameRecordFormat::END_TAG) {
+            uint32_t numTurns;
+            if (reader.read(numTurns) && reader.read(winner) && reader.read(recordedNanoseconds)) {
+                corrupted = numTurns != turns.size();
+            }
+            break;
+        } else {
+            corrupted = true;
+        }
+    }
+    if (corrupted || snapshots.empty() || snapshots.front().turn != 0) {
+        cout << "The game record " << fileName << " is corrupted" << endl;
+        clear();
+        return false;
+    }
+
+    restore(snapshots.front());
+    return true;
+}
+
+bool GameReplay::seek(int turn) {
+    if (map == nullptr || turn < 0 || turn > getNumTurns()) {
+        return false;
+    }
+    // the closest snapshot before the turn, unless the board already is between it and the turn
+    const Snapshot *closest = &snapshots.front();
+    for (auto &snapshot : snapshots) {
+        if (snapshot.turn <= turn && snapshot.turn > closest->turn) {
+            closest = &snapshot;
+        }
+    }
+    if (this->turn < closest->turn || this->turn > turn) {
+        restore(*closest);
+    }
+    SilentOutput silentOutput;
+    while (this->turn < turn) {
+        replayTurn(turns[this->turn]);
+        this->turn++;
+    }
+    return true;
+}
+
+bool GameReplay::step() {
+    if (map == nullptr || turn >= getNumTurns()) {
+        return false;
+    }
+    SilentOutput silentOutput;
+    replayTurn(turns[turn]);
+    turn++;
+    return true;
+}
+
+int GameReplay::getTurn() const {
+    return turn;
+}
+
+int GameReplay::getNumTurns() const {
+    return static_cast<int>(turns.size());
+}
+
+unsigned GameReplay::getSeed() const {
+    return seed;
+}
+
+long GameReplay::getNumOrdersReplayed() const {
+    return numOrdersReplayed;
+}
+
+double GameReplay::getRecordedSeconds() const {
+    return recordedNanoseconds / 1e9;
+}
+
+Map *GameReplay::getMap() const {
+    return map;
+}
+
+const vector<Player *> &GameReplay::getPlayers() const {
+    return players;
+}
+
+bool GameReplay::matchesFinalSnapshot() const {
+    if (map == nullptr || snapshots.back().turn != turn) {
+        return false;
+    }
+    const Snapshot &snapshot = snapshots.back();
+    for (int i = 0; i < map->getNumTerritories(); i++) {
+        Territory *territory = map->getTerritories()[i];
+        if (territory->getOwner() != playerOf(snapshot.owners[i]) || territory->getNumberOfArmies() != snapshot.armies[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+string GameReplay::describe() const {
+    if (map == nullptr) {
+        return "No game record loaded\n";
+    }
+    string description = "Turn " + to_string(turn) + " of " + to_string(getNumTurns()) + " (seed " + to_string(seed) + ")\n";
+    for (auto &player : players) {
+        int numTerritories = 0;
+        int numArmies = 0;
+        for (int i = 0; i < map->getNumTerritories(); i++) {
+            if (map->getTerritories()[i]->getOwner() == player) {
+                numTerritories++;
+                numArmies += map->getTerritories()[i]->getNumberOfArmies();
+            }
+        }
+        description += "\t" + player->getName() + ": " + to_string(numTerritories) + " territories, " +
+                       to_string(numArmies) + " armies\n";
+    }
+    if (recordedNanoseconds > 0) {
+        description += "Result: " + (winner != GameRecordFormat::NO_PLAYER && winner < players.size() ? players[winner]->getName() : string("Draw")) + "\n";
+    }
+    return description;
+}
+
+// sets the owner and armies of every territory as they were in a snapshot
+void GameReplay::restore(const Snapshot &snapshot) {
+    for (size_t i = 1; i < players.size(); i++) {
+        players[i]->removeAllTerritories();
+    }
+    for (int i = 0; i < map->getNumTerritories(); i++) {
+        Territory *territory = map->getTerritories()[i];
+        if (territory->getOwner() != nullptr) {
+            territory->getOwner()->removeTerritory(territory);
+        }
+    }
+    for (int i = 0; i < map->getNumTerritories(); i++) {
+        Territory *territory = map->getTerritories()[i];
+        Player *owner = playerOf(snapshot.owners[i]);
+        if (owner != nullptr) {
+            owner->addTerritory(territory);
+        }
+        territory->setNumberOfArmies(snapshot.armies[i]);
+        territory->setPendingIncomingArmies(0);
+        territory->setPendingOutgoingArmies(0);
+    }
+    turn = snapshot.turn;
+}
+
+// executes the records of the orders of a turn in the order the engine did
+void GameReplay::replayTurn(const TurnRecord &turnRecord) {
+    for (size_t i = 0; i < players.size(); i++) {
+        if (turnRecord.strategies[i] < GameEngine::strategyType.size()) {
+            players[i]->setStrategy(turnRecord.strategies[i]);
+        }
+    }
+    size_t end = turnRecord.firstOrder + turnRecord.numOrders;
+    for (size_t i = turnRecord.firstOrder; i < end; i++) {
+        const OrderRecord &record = orders[i];
+        Player *issuer = playerOf(record.issuer);
+        // the territories taken at once by a player are handed over together, as during the game
+        if (record.type == GameRecordFormat::TRANSFER) {
+            vector<Territory*> transferred = {territoryOf(record.destination)};
+            while (i + 1 < end && orders[i + 1].type == GameRecordFormat::TRANSFER && orders[i + 1].issuer == record.issuer) {
+                transferred.push_back(territoryOf(orders[++i].destination));
+            }
+            // a neutral player losing a territory turns aggressive
+            for (auto &territory : transferred) {
+                Player *owner = territory->getOwner();
+                if (owner != nullptr && owner->getStrategy() == GameEngine::strategyType.at(strategy::Neutral)) {
+                    owner->setStrategy(strategy::Aggressive);
+                }
+            }
+            map->transferTerritories(transferred, issuer);
+            continue;
+        }
+        OrderKernel::execute(record, map, players);
+        numOrdersReplayed++;
+    }
+}
+
+Territory *GameReplay::territoryOf(int32_t id) const {
+    return OrderKernel::territoryOf(map, id);
+}
+
+Player *GameReplay::playerOf(uint8_t index) const {
+    return OrderKernel::playerOf(players, index);
+}
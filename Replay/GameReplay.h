@@ -0,0 +1,97 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#ifndef COMP345_N11_GAMEREPLAY_H
+#define COMP345_N11_GAMEREPLAY_H
+
+#include "GameRecorder.h"
+#include <string>
+#include <vector>
+using namespace std;
+
+class Map;
+class Territory;
+class Player;
+
+/**
+ * Replays a game written by GameRecorder: the recorded orders are rebuilt and executed through Order::execute, no
+ * player strategy is run and the output of the orders is discarded, which makes a replay much faster than the game.
+ * Any turn can be reached quickly by restoring the closest snapshot before it and replaying the turns in between.
+ */
+class GameReplay {
+public:
+    GameReplay();
+    GameReplay(const GameReplay &anotherReplay) = delete;
+    GameReplay& operator = (const GameReplay &anotherReplay) = delete;
+    ~GameReplay();
+
+    /**
+     * reads a record, loads its map and sets the board as it was when the game started
+     * @return false if the record could not be read or its map changed since it was recorded
+     */
+    bool load(const string &fileName);
+
+    /**
+     * sets the board as it was at the end of a turn, 0 being the start of the game
+     * @return false if the record has no such turn
+     */
+    bool seek(int turn);
+
+    /**
+     * replays the next turn
+     * @return false once the last recorded turn was replayed
+     */
+    bool step();
+
+    int getTurn() const;
+    int getNumTurns() const;
+    unsigned getSeed() const;
+    long getNumOrdersReplayed() const;
+    double getRecordedSeconds() const; //duration of the recorded game, 0 if the record has no end block
+
+    /**
+     * whether the board is the one recorded at the end of the game, after seeking to the last turn
+     */
+    bool matchesFinalSnapshot() const;
+
+    /**
+     * the winner and the territories and armies of each player
+     */
+    string describe() const;
+
+    Map* getMap() const;
+    const vector<Player*> &getPlayers() const;
+
+private:
+    struct TurnRecord {
+        size_t firstOrder;
+        size_t numOrders;
+        vector<uint8_t> strategies;
+    };
+    struct Snapshot {
+        int turn;
+        vector<uint8_t> owners;
+        vector<int32_t> armies;
+    };
+
+    unsigned seed;
+    string mapFileName;
+    Map *map;
+    vector<Player*> players; //the neutral player of the engine followed by the players created for the replay
+    vector<TurnRecord> turns;
+    vector<OrderRecord> orders;
+    vector<Snapshot> snapshots;
+    uint8_t winner;
+    int64_t recordedNanoseconds;
+    int turn;
+    long numOrdersReplayed;
+
+    void clear();
+    void restore(const Snapshot &snapshot);
+    void replayTurn(const TurnRecord &turnRecord);
+    Territory* territoryOf(int32_t id) const;
+    Player* playerOf(uint8_t index) const;
+};
+
+#endif //COMP345_N11_GAMEREPLAY_H
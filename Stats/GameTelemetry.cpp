@@ -0,0 +1,105 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "GameTelemetry.h"
+#include "../Map/BoardStats.h"
+#include "../Player/Player.h"
+#include <algorithm>
+#include <fstream>
+
+GameTelemetry::GameTelemetry() : active(false) {}
+
+void GameTelemetry::begin(const vector<Player*> &players, int turns) {
+    end();
+    this->players = players;
+    turnIssued.assign(players.size(), 0);
+    turnSucceeded.assign(players.size(), 0);
+    size_t rows = players.size() * static_cast<size_t>(max(turns, 0));
+    this->turns.reserve(rows);
+    playerIndexes.reserve(rows);
+    territories.reserve(rows);
+    armies.reserve(rows);
+    continents.reserve(rows);
+    issued.reserve(rows);
+    succeeded.reserve(rows);
+    active = true;
+}
+
+bool GameTelemetry::isActive() const {
+    return active;
+}
+
+void GameTelemetry::ordersIssued(const Player *player, long count) {
+    int index = active ? indexOf(player) : -1;
+    if (index >= 0) {
+        turnIssued[index] += count;
+    }
+}
+
+void GameTelemetry::orderExecuted(const Player *player, bool valid) {
+    int index = active && valid ? indexOf(player) : -1;
+    if (index >= 0) {
+        turnSucceeded[index]++;
+    }
+}
+
+// the board statistics come from a single sweep of the board, shared with the next reinforcement phase
+void GameTelemetry::endTurn(int turn, BoardStats *boardStats) {
+    if (!active) {
+        return;
+    }
+    for (size_t i = 0; i < players.size(); i++) {
+        const PlayerBoardStats &stats = boardStats->of(players[i]);
+        turns.push_back(turn);
+        playerIndexes.push_back(static_cast<uint8_t>(i));
+        territories.push_back(stats.territories);
+        armies.push_back(stats.armies);
+        continents.push_back(stats.continents);
+        issued.push_back(static_cast<int32_t>(turnIssued[i]));
+        succeeded.push_back(static_cast<int32_t>(turnSucceeded[i]));
+        turnIssued[i] = 0;
+        turnSucceeded[i] = 0;
+    }
+}
+
+bool GameTelemetry::save(const string &fileName) const {
+    ofstream file(fileName);
+    if (!file) {
+        return false;
+    }
+    file << "turn,player,territories,armies,continents,orders_issued,orders_succeeded\n";
+    for (size_t row = 0; row < turns.size(); row++) {
+        file << turns[row] << ',' << players[playerIndexes[row]]->getName() << ',' << territories[row] << ','
+             << armies[row] << ',' << continents[row] << ',' << issued[row] << ',' << succeeded[row] << '\n';
+    }
+    return static_cast<bool>(file);
+}
+
+void GameTelemetry::end() {
+    active = false;
+    players.clear();
+    turnIssued.clear();
+    turnSucceeded.clear();
+    turns.clear();
+    playerIndexes.clear();
+    territories.clear();
+    armies.clear();
+    continents.clear();
+    issued.clear();
+    succeeded.clear();
+}
+
+size_t GameTelemetry::getNumRows() const {
+    return turns.size();
+}
+
+// a game has a handful of players, a linear search is the fastest
+int GameTelemetry::indexOf(const Player *player) const {
+    for (size_t i = 0; i < players.size(); i++) {
+        if (players[i] == player) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,77 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#ifndef COMP345_N11_GAMETELEMETRY_H
+#define COMP345_N11_GAMETELEMETRY_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+using namespace std;
+
+class Player;
+class BoardStats;
+
+/**
+ * Per-turn series of a game, one row per player and turn: territories, armies and continents held at the end of the
+ * turn, orders issued and orders that were still valid when they were executed during the turn.
+ * The rows are kept in one preallocated column per field and only formatted when the series is saved, so recording a
+ * turn costs a few appends per player.
+ */
+class GameTelemetry {
+public:
+    GameTelemetry();
+
+    /**
+     * starts the series of a game, the previous one is dropped
+     * @param players the players of the game, in the order of their rows
+     * @param turns turns the game may last, room is reserved for all of them
+     */
+    void begin(const vector<Player*> &players, int turns);
+
+    // whether a game is being recorded
+    bool isActive() const;
+
+    // counted in the current turn of a player of the game, other players are ignored
+    void ordersIssued(const Player *player, long count);
+    void orderExecuted(const Player *player, bool valid);
+
+    /**
+     * appends the rows of all the players for the turn that just ended, and starts counting the orders of the next one
+     * @param boardStats statistics of the board of the game
+     */
+    void endTurn(int turn, BoardStats *boardStats);
+
+    /**
+     * writes the series as CSV, with a header line then one line per row
+     * @return false if the file could not be written
+     */
+    bool save(const string &fileName) const;
+
+    /**
+     * stops recording, the series is dropped
+     */
+    void end();
+
+    size_t getNumRows() const;
+
+private:
+    vector<Player*> players;
+    vector<long> turnIssued; //orders of each player in the current turn
+    vector<long> turnSucceeded;
+    bool active;
+
+    // the columns
+    vector<int32_t> turns;
+    vector<uint8_t> playerIndexes;
+    vector<int32_t> territories;
+    vector<int64_t> armies;
+    vector<int32_t> continents;
+    vector<int32_t> issued;
+    vector<int32_t> succeeded;
+
+    int indexOf(const Player *player) const;
+};
+
+#endif //COMP345_N11_GAMETELEMETRY_H
@@ -0,0 +1,226 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "Stats.h"
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <new>
+#include <sstream>
+
+namespace {
+    // zero-initialized before any dynamic initialization, so operator new can use them from the very first allocation
+    atomic<long> counters[static_cast<int>(StatCounter::NUM_COUNTERS)];
+    TimerStat phases[static_cast<int>(StatPhase::NUM_PHASES)];
+    TimerStat strategies[NUM_STAT_STRATEGIES];
+    TimerStat orders[NUM_STAT_ORDER_TYPES];
+    atomic<long> heapBytes;
+    atomic<long> peakHeapBytes;
+
+    // every block allocated by new starts with its size, so delete knows how many bytes it gives back
+    const size_t HEADER_SIZE = alignof(max_align_t);
+
+    const char *COUNTER_NAMES[] = {"ordersIssued", "ordersExecuted", "ordersInvalid", "ordersCoalesced",
+                                   "territoriesTransferred", "boardSweeps", "allocations", "allocatedBytes"};
+    const char *PHASE_NAMES[] = {"reinforcement", "issueOrders", "executeOrders", "mapLoading", "mapValidation"};
+    const char *STRATEGY_NAMES[] = {"Aggressive", "Human", "Neutral", "Cheater", "Benevolent"};
+    const char *ORDER_NAMES[] = {"Deploy", "Advance", "Bomb", "Blockade", "Airlift", "Negotiate"};
+
+    // the timers of the table that were used at least once
+    void reportTimers(ostringstream &buffer, const char *title, TimerStat *timers, const char **names, int numTimers) {
+        buffer << title << endl;
+        for (int i = 0; i < numTimers; i++) {
+            long calls = timers[i].calls.load(memory_order_relaxed);
+            if (calls == 0) {
+                continue;
+            }
+            double milliseconds = timers[i].nanoseconds.load(memory_order_relaxed) / 1e6;
+            buffer << "  " << left << setw(24) << names[i] << right << setw(12) << fixed << setprecision(3)
+                   << milliseconds << " ms" << setw(10) << calls << " calls" << endl;
+        }
+    }
+
+    void timersToJson(ostringstream &buffer, const char *title, TimerStat *timers, const char **names, int numTimers) {
+        buffer << "  \"" << title << "\": {";
+        for (int i = 0; i < numTimers; i++) {
+            buffer << (i == 0 ? "\n" : ",\n") << "    \"" << names[i] << "\": {\"ms\": " << fixed << setprecision(3)
+                   << timers[i].nanoseconds.load(memory_order_relaxed) / 1e6
+                   << ", \"calls\": " << timers[i].calls.load(memory_order_relaxed) << "}";
+        }
+        buffer << "\n  }";
+    }
+
+    void resetTimers(TimerStat *timers, int numTimers) {
+        for (int i = 0; i < numTimers; i++) {
+            timers[i].nanoseconds.store(0, memory_order_relaxed);
+            timers[i].calls.store(0, memory_order_relaxed);
+        }
+    }
+}
+
+void Stats::increment(StatCounter counter, long amount) {
+    counters[static_cast<int>(counter)].fetch_add(amount, memory_order_relaxed);
+}
+
+long Stats::get(StatCounter counter) {
+    return counters[static_cast<int>(counter)].load(memory_order_relaxed);
+}
+
+TimerStat &Stats::phase(StatPhase phase) {
+    return phases[static_cast<int>(phase)];
+}
+
+TimerStat &Stats::strategy(int strategyType) {
+    return strategies[strategyType];
+}
+
+TimerStat &Stats::order(int orderType) {
+    return orders[orderType];
+}
+
+void Stats::reset() {
+    for (auto &counter : counters) {
+        counter.store(0, memory_order_relaxed);
+    }
+    resetTimers(phases, static_cast<int>(StatPhase::NUM_PHASES));
+    resetTimers(strategies, NUM_STAT_STRATEGIES);
+    resetTimers(orders, NUM_STAT_ORDER_TYPES);
+}
+
+string Stats::report() {
+    ostringstream buffer;
+    buffer << "Engine statistics" << endl << "Counters" << endl;
+    for (int i = 0; i < static_cast<int>(StatCounter::NUM_COUNTERS); i++) {
+        buffer << "  " << left << setw(24) << COUNTER_NAMES[i] << right << setw(12) << counters[i].load(memory_order_relaxed) << endl;
+    }
+    reportTimers(buffer, "Phases", phases, PHASE_NAMES, static_cast<int>(StatPhase::NUM_PHASES));
+    reportTimers(buffer, "Issuing orders, per strategy", strategies, STRATEGY_NAMES, NUM_STAT_STRATEGIES);
+    reportTimers(buffer, "Executing orders, per order type", orders, ORDER_NAMES, NUM_STAT_ORDER_TYPES);
+    return buffer.str();
+}
+
+string Stats::toJson() {
+    ostringstream buffer;
+    buffer << "{" << endl << "  \"counters\": {";
+    for (int i = 0; i < static_cast<int>(StatCounter::NUM_COUNTERS); i++) {
+        buffer << (i == 0 ? "\n" : ",\n") << "    \"" << COUNTER_NAMES[i] << "\": " << counters[i].load(memory_order_relaxed);
+    }
+    buffer << "\n  }," << endl;
+    timersToJson(buffer, "phases", phases, PHASE_NAMES, static_cast<int>(StatPhase::NUM_PHASES));
+    buffer << "," << endl;
+    timersToJson(buffer, "strategies", strategies, STRATEGY_NAMES, NUM_STAT_STRATEGIES);
+    buffer << "," << endl;
+    timersToJson(buffer, "orders", orders, ORDER_NAMES, NUM_STAT_ORDER_TYPES);
+    buffer << endl << "}" << endl;
+    return buffer.str();
+}
+
+bool Stats::dumpJson(const string &path) {
+    ofstream file(path);
+    if (!file.is_open()) {
+        return false;
+    }
+    file << toJson();
+    return file.good();
+}
+
+long Stats::getHeapBytes() {
+    return heapBytes.load(memory_order_relaxed);
+}
+
+long Stats::getPeakHeapBytes() {
+    return peakHeapBytes.load(memory_order_relaxed);
+}
+
+void Stats::resetPeakHeap() {
+    peakHeapBytes.store(heapBytes.load(memory_order_relaxed), memory_order_relaxed);
+}
+
+string Stats::formatBytes(long bytes) {
+    ostringstream buffer;
+    if (bytes < 10 * 1024) {
+        buffer << bytes << " B";
+    } else if (bytes < 10 * 1024 * 1024) {
+        buffer << fixed << setprecision(1) << bytes / 1024.0 << " KB";
+    } else {
+        buffer << fixed << setprecision(1) << bytes / (1024.0 * 1024.0) << " MB";
+    }
+    return buffer.str();
+}
+
+ScopedTimer::ScopedTimer(TimerStat &timer) : timer(timer), start(chrono::steady_clock::now()) { }
+
+ScopedTimer::~ScopedTimer() {
+    long long elapsed = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+    timer.nanoseconds.fetch_add(elapsed, memory_order_relaxed);
+    timer.calls.fetch_add(1, memory_order_relaxed);
+}
+
+/*
+ * Global allocation functions, counting every allocation made through new and the bytes in use
+ */
+
+void *operator new(size_t size) {
+    Stats::increment(StatCounter::ALLOCATIONS);
+    Stats::increment(StatCounter::ALLOCATED_BYTES, static_cast<long>(size));
+    void *block = malloc(HEADER_SIZE + size);
+    if (block == nullptr) {
+        throw bad_alloc();
+    }
+    *static_cast<size_t*>(block) = size;
+    long bytes = heapBytes.fetch_add(static_cast<long>(size), memory_order_relaxed) + static_cast<long>(size);
+    long peak = peakHeapBytes.load(memory_order_relaxed);
+    while (bytes > peak && !peakHeapBytes.compare_exchange_weak(peak, bytes, memory_order_relaxed)) {}
+    return static_cast<char*>(block) + HEADER_SIZE;
+}
+
+void *operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void *memory) noexcept {
+    if (memory == nullptr) {
+        return;
+    }
+    void *block = static_cast<char*>(memory) - HEADER_SIZE;
+    heapBytes.fetch_sub(static_cast<long>(*static_cast<size_t*>(block)), memory_order_relaxed);
+    free(block);
+}
+
+void operator delete[](void *memory) noexcept {
+    operator delete(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept {
+    operator delete(memory);
+}
+
+void operator delete[](void *memory, size_t) noexcept {
+    operator delete(memory);
+}
+
+void *operator new(size_t size, const nothrow_t &) noexcept {
+    try {
+        return operator new(size);
+    } catch (const bad_alloc &) {
+        return nullptr;
+    }
+}
+
+void *operator new[](size_t size, const nothrow_t &) noexcept {
+    try {
+        return operator new(size);
+    } catch (const bad_alloc &) {
+        return nullptr;
+    }
+}
+
+void operator delete(void *memory, const nothrow_t &) noexcept {
+    operator delete(memory);
+}
+
+void operator delete[](void *memory, const nothrow_t &) noexcept {
+    operator delete(memory);
+}
@@ -0,0 +1,109 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#ifndef COMP345_N11_STATS_H
+#define COMP345_N11_STATS_H
+
+#include <atomic>
+#include <chrono>
+#include <string>
+using namespace std;
+
+enum class StatCounter {
+    ORDERS_ISSUED,
+    ORDERS_EXECUTED,
+    ORDERS_INVALID,
+    ORDERS_COALESCED,
+    TERRITORIES_TRANSFERRED,
+    BOARD_SWEEPS,
+    ALLOCATIONS,
+    ALLOCATED_BYTES,
+    NUM_COUNTERS
+};
+
+enum class StatPhase {
+    REINFORCEMENT,
+    ISSUE_ORDERS,
+    EXECUTE_ORDERS,
+    MAP_LOADING,
+    MAP_VALIDATION,
+    NUM_PHASES
+};
+
+const int NUM_STAT_STRATEGIES = 5; //values of the strategy enum of Player.h
+const int NUM_STAT_ORDER_TYPES = 6; //values of the OrderType enum of Orders.h
+
+/**
+ * Accumulated time and number of calls of a timed section.
+ */
+struct TimerStat {
+    atomic<long long> nanoseconds;
+    atomic<long> calls;
+};
+
+/**
+ * Built-in performance counters and timers of the engine, so regressions can be diagnosed without a profiler.
+ * Everything is process wide and atomic, which lets any module update the statistics without being handed a context.
+ * The allocation counters and the heap use are updated by the global operator new and delete defined in Stats.cpp.
+ */
+class Stats {
+public:
+    static void increment(StatCounter counter, long amount = 1);
+    static long get(StatCounter counter);
+
+    static TimerStat &phase(StatPhase phase);
+    static TimerStat &strategy(int strategyType); //issueOrder time of a player strategy, indexed by the strategy enum
+    static TimerStat &order(int orderType); //execution time of an order type, indexed by OrderType
+
+    static void reset();
+
+    /**
+     * bytes allocated through new and not deleted yet
+     */
+    static long getHeapBytes();
+
+    /**
+     * most bytes allocated through new at once since the last resetPeakHeap, or since the start
+     */
+    static long getPeakHeapBytes();
+    static void resetPeakHeap();
+
+    /**
+     * a number of bytes in B, KB or MB
+     */
+    static string formatBytes(long bytes);
+
+    /**
+     * human readable table of all the statistics, printed by the stats command
+     */
+    static string report();
+
+    /**
+     * all the statistics as a JSON object, times are in milliseconds
+     */
+    static string toJson();
+
+    /**
+     * writes toJson() to a file
+     * @return false if the file could not be written
+     */
+    static bool dumpJson(const string &path);
+};
+
+/**
+ * Adds the time spent between its construction and its destruction to a timer.
+ */
+class ScopedTimer {
+public:
+    explicit ScopedTimer(TimerStat &timer);
+    ScopedTimer(const ScopedTimer &anotherTimer) = delete;
+    ScopedTimer& operator = (const ScopedTimer &anotherTimer) = delete;
+    ~ScopedTimer();
+
+private:
+    TimerStat &timer;
+    chrono::steady_clock::time_point start;
+};
+
+#endif //COMP345_N11_STATS_H
@@ -0,0 +1,125 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#include "Trace.h"
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace {
+    struct TraceEvent {
+        string name;
+        const char *category;
+        string args;
+        long long start; //nanoseconds since the trace started
+        long long duration;
+    };
+
+    // spans of one thread, only ever touched by that thread while tracing is on
+    struct ThreadBuffer {
+        int threadId;
+        vector<TraceEvent> events;
+    };
+
+    atomic<bool> enabled(false);
+    chrono::steady_clock::time_point traceStart;
+    string traceFileName;
+    mutex buffersMutex; //guards the list of buffers, a thread adds its buffer once
+    vector<unique_ptr<ThreadBuffer>> buffers; //kept for the whole process, threads keep a pointer to theirs
+
+    ThreadBuffer *threadBuffer() {
+        thread_local ThreadBuffer *buffer = nullptr;
+        if (buffer == nullptr) {
+            lock_guard<mutex> lock(buffersMutex);
+            buffers.emplace_back(new ThreadBuffer{static_cast<int>(buffers.size()) + 1, {}});
+            buffer = buffers.back().get();
+        }
+        return buffer;
+    }
+
+    // microseconds, the unit of the Chrome trace format
+    string microseconds(long long nanoseconds) {
+        ostringstream buffer;
+        buffer << fixed << setprecision(3) << nanoseconds / 1000.0;
+        return buffer.str();
+    }
+}
+
+void Trace::start(const string &fileName) {
+    lock_guard<mutex> lock(buffersMutex);
+    for (auto &buffer : buffers) {
+        buffer->events.clear();
+    }
+    traceFileName = fileName;
+    traceStart = chrono::steady_clock::now();
+    enabled.store(true, memory_order_release);
+}
+
+// called once the threads that were traced are done
+bool Trace::stop() {
+    if (!enabled.exchange(false, memory_order_acq_rel)) {
+        return false;
+    }
+    lock_guard<mutex> lock(buffersMutex);
+    ofstream file(traceFileName, ios::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+    file << "{\"traceEvents\": [" << endl;
+    file << "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 0, \"args\": {\"name\": \"Warzone\"}}";
+    for (auto &buffer : buffers) {
+        file << "," << endl << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << buffer->threadId
+             << ", \"args\": {\"name\": \"thread " << buffer->threadId << "\"}}";
+        for (auto &event : buffer->events) {
+            file << "," << endl << "{\"name\": \"" << escape(event.name) << "\", \"cat\": \"" << event.category
+                 << "\", \"ph\": \"X\", \"ts\": " << microseconds(event.start) << ", \"dur\": " << microseconds(event.duration)
+                 << ", \"pid\": 1, \"tid\": " << buffer->threadId << ", \"args\": {" << event.args << "}}";
+        }
+        buffer->events.clear();
+    }
+    file << endl << "], \"displayTimeUnit\": \"ms\"}" << endl;
+    return file.good();
+}
+
+bool Trace::isEnabled() {
+    return enabled.load(memory_order_acquire);
+}
+
+string Trace::escape(const string &text) {
+    string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            escaped += ' ';
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+// nothing is copied while tracing is off
+TraceSpan::TraceSpan(const string &name, const char *category, const string &args) : enabled(Trace::isEnabled()), category(category) {
+    if (enabled) {
+        this->name = name;
+        this->args = args;
+        start = chrono::steady_clock::now();
+    }
+}
+
+TraceSpan::~TraceSpan() {
+    if (!enabled || !Trace::isEnabled()) {
+        return;
+    }
+    auto end = chrono::steady_clock::now();
+    threadBuffer()->events.push_back({move(name), category, move(args),
+                                      chrono::duration_cast<chrono::nanoseconds>(start - traceStart).count(),
+                                      chrono::duration_cast<chrono::nanoseconds>(end - start).count()});
+}
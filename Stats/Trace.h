@@ -0,0 +1,62 @@
+//
+// Created by agent on 2026-10-19.
+//
+
+#ifndef COMP345_N11_TRACE_H
+#define COMP345_N11_TRACE_H
+
+#include <chrono>
+#include <string>
+using namespace std;
+
+/**
+ * Opt-in timeline of the engine, written as Chrome trace events that Perfetto or chrome://tracing can open.
+ * Every thread appends the spans it measures to a buffer of its own, so tracing takes no lock while the game runs;
+ * the buffers of all the threads are written at once by stop.
+ * While tracing is off, a span costs a single atomic load.
+ */
+class Trace {
+public:
+    /**
+     * starts recording spans, they are written to the file when tracing stops
+     */
+    static void start(const string &fileName);
+
+    /**
+     * stops recording spans and writes all of them
+     * @return false if the trace could not be written
+     */
+    static bool stop();
+
+    static bool isEnabled();
+
+    /**
+     * a string escaped to be a JSON string value, without its quotes
+     */
+    static string escape(const string &text);
+};
+
+/**
+ * Adds to the trace the time spent between its construction and its destruction, as a span of the calling thread.
+ */
+class TraceSpan {
+public:
+    /**
+     * @param name name of the span, shown on the timeline
+     * @param category group of spans the span belongs to, a string that outlives the trace
+     * @param args members of the JSON object of the arguments of the span, e.g. "\"turn\": 3", empty for none
+     */
+    TraceSpan(const string &name, const char *category, const string &args = "");
+    TraceSpan(const TraceSpan &anotherSpan) = delete;
+    TraceSpan& operator = (const TraceSpan &anotherSpan) = delete;
+    ~TraceSpan();
+
+private:
+    bool enabled;
+    string name;
+    const char *category;
+    string args;
+    chrono::steady_clock::time_point start;
+};
+
+#endif //COMP345_N11_TRACE_H
@@ -5,7 +5,7 @@
 #include "TestDriver.h"
 
 int main(int argc, char* argv[]){
-    GameEngineDriver();
+    GameEngineDriver(argc, argv);
 
     // test part 1: replace the following lines to GECommands
 